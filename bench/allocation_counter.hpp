@@ -0,0 +1,103 @@
+/**
+ * @file allocation_counter.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Global operator new replacement counting heap allocations
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions, include it from exactly one
+// translation unit of a benchmark executable.
+
+namespace bench {
+
+inline std::atomic<unsigned long> allocation_count {0};
+inline std::atomic<unsigned long> allocated_bytes {0};
+
+inline unsigned long getAllocationCount() {return allocation_count.load(std::memory_order_relaxed);}
+inline unsigned long getAllocatedBytes() {return allocated_bytes.load(std::memory_order_relaxed);}
+
+}
+
+void* operator new(std::size_t size)
+{
+  bench::allocation_count.fetch_add(1, std::memory_order_relaxed);
+  bench::allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  if (void* pointer {std::malloc(size == 0 ? 1 : size)})
+    return pointer;
+
+  throw std::bad_alloc {};
+}
+
+void* operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+// The aligned forms are what std::pmr::new_delete_resource() calls
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  bench::allocation_count.fetch_add(1, std::memory_order_relaxed);
+  bench::allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+  const auto align {static_cast<std::size_t>(alignment)};
+
+  if (void* pointer {std::aligned_alloc(align, (size + align - 1) / align * align)})
+    return pointer;
+
+  throw std::bad_alloc {};
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return ::operator new(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept
+{
+  std::free(pointer);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file bench_async_planner.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Throughput, latency and cancellation of the asynchronous planner
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <random>
+#include <utility>
+
+#include "bench_common.hpp"
+#include "async_planner.hpp"
+
+namespace {
+
+constexpr unsigned int query_count {2000};
+constexpr unsigned int query_radius {60};
+
+using Query = std::pair<project2::Position, project2::Position>;
+
+// Free start and goal cells a few steps apart
+std::vector<Query> makeQueries(const project2::OccupancyGrid& occupancy_grid)
+{
+  const auto& grid_spec {occupancy_grid.getGridSpec()};
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<long> column {0, grid_spec.getColumns() - 1};
+  std::uniform_int_distribution<long> row {0, grid_spec.getRows() - 1};
+  std::uniform_int_distribution<long> offset {-static_cast<long>(query_radius), query_radius};
+
+  std::vector<Query> queries {};
+
+  while (queries.size() < query_count) {
+    const long start_x {column(generator)};
+    const long start_y {row(generator)};
+    const long goal_x {start_x + offset(generator)};
+    const long goal_y {start_y + offset(generator)};
+
+    if (occupancy_grid.isBlocked(start_x, start_y) || occupancy_grid.isBlocked(goal_x, goal_y))
+      continue;
+
+    const auto cell_size {grid_spec.cell_size};
+    queries.push_back({
+      {static_cast<unsigned int>(start_x) * cell_size, static_cast<unsigned int>(start_y) * cell_size},
+      {static_cast<unsigned int>(goal_x) * cell_size, static_cast<unsigned int>(goal_y) * cell_size}});
+  }
+
+  return queries;
+}
+
+double toMilliseconds(project2::SearchLimits::Clock::duration duration)
+{
+  return std::chrono::duration<double, std::milli> {duration}.count();
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+
+  const auto queries {makeQueries(occupancy_grid)};
+
+  // Reference costs, one thread and one workspace
+  std::vector<float> costs (queries.size(), -1.F);
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+
+  bench::Timer sequential_timer {};
+  for (unsigned int i {0}; i < queries.size(); i++) {
+    if (project2::planPath<project2::EightConnected>(queries[i].first, queries[i].second, occupancy_grid, workspace)
+      == project2::SearchStatus::FOUND)
+      costs[i] = workspace.getDistance(occupancy_grid.getIndex(queries[i].second));
+  }
+  const double sequential_time {sequential_timer.seconds()};
+
+  std::cout << queries.size() << " queries on the calling thread: " << sequential_time * 1e3 << " ms\n";
+
+  for (const unsigned int thread_count: {1U, 2U, 4U}) {
+    project2::AsyncPlanner planner {occupancy_grid, thread_count};
+    std::vector<project2::PlanHandle> handles {};
+    handles.reserve(queries.size());
+
+    bench::Timer timer {};
+    for (const auto& query: queries)
+      handles.push_back(planner.planAsync(query.first, query.second));
+
+    unsigned long mismatches {0};
+    for (unsigned int i {0}; i < handles.size(); i++) {
+      const auto result {handles[i].get()};
+      mismatches += (result.status == project2::SearchStatus::FOUND ? result.cost : -1.F) != costs[i];
+    }
+    const double total_time {timer.seconds()};
+
+    const auto metrics {planner.getMetrics()};
+
+    std::cout << thread_count << " workers: " << total_time * 1e3 << " ms, max queue depth "
+      << metrics.max_queue_depth << ", queue wait mean " << toMilliseconds(metrics.total_queue_time) / metrics.completed
+      << " ms max " << toMilliseconds(metrics.max_queue_time) << " ms, run mean "
+      << toMilliseconds(metrics.total_run_time) / metrics.completed << " ms max "
+      << toMilliseconds(metrics.max_run_time) << " ms, " << mismatches << " costs differ\n";
+  }
+
+  // Long query cancelled while running, and one cancelled while queued
+  // behind it
+  {
+    project2::AsyncPlanner planner {occupancy_grid, 1};
+    std::atomic<unsigned int> callbacks {0};
+
+    auto running {planner.planAsync({60, 60}, {1150, 250}, {},
+      [&](const project2::PlanResult&) {callbacks++;})};
+    auto queued {planner.planAsync({60, 60}, {1150, 250}, {},
+      [&](const project2::PlanResult&) {callbacks++;})};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {5});
+    queued.cancel();
+    running.cancel();
+
+    const auto running_result {running.get()};
+    const auto queued_result {queued.get()};
+
+    std::cout << "Cancelled while running: " << project2::toString(running_result.status) << " after "
+      << toMilliseconds(running_result.run_time) << " ms, partial path of " << running_result.path.size()
+      << " cells; while queued: " << project2::toString(queued_result.status) << ", " << callbacks
+      << " callbacks\n";
+
+    project2::PlanOptions options {};
+    options.timeout = std::chrono::milliseconds {2};
+    const auto timed_out {planner.planAsync({60, 60}, {1150, 250}, options).get()};
+
+    std::cout << "2 ms timeout: " << project2::toString(timed_out.status) << " after "
+      << toMilliseconds(timed_out.run_time) << " ms\n";
+
+    const auto off_grid {planner.planAsync({60, 60}, {5000, 250}).get()};
+
+    std::cout << "Goal off the grid: " << project2::toString(off_grid.status) << ", path of "
+      << off_grid.path.size() << " cells\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file bench_bidirectional_search.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Latency of the bidirectional search with and without its second thread
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cmath>
+#include <thread>
+#include <type_traits>
+
+#include "bench_common.hpp"
+#include "bidirectional_search.hpp"
+#include "distance_field.hpp"
+
+namespace {
+
+constexpr unsigned int repeats {5};
+
+template <typename Cost>
+void runQuery(
+  const char* label,
+  const project2::Position& start,
+  const project2::Position& goal,
+  const project2::OccupancyGrid& occupancy_grid,
+  const project2::DistanceField* clearance_cost)
+{
+  using Distance = typename Cost::value_type;
+
+  // planPath with the 8-connected moves is what searchDijkstra runs
+  project2::BasicPlannerWorkspace<Distance> workspace {occupancy_grid.size()};
+  double serial_time {1e9};
+
+  for (unsigned int i {0}; i < repeats; i++) {
+    bench::Timer timer {};
+    project2::planPath<project2::EightConnected, project2::GridSpec, project2::RowMajorLayout<project2::GridSpec>,
+      Cost>(start, goal, occupancy_grid, workspace, clearance_cost);
+    serial_time = std::min(serial_time, timer.seconds());
+  }
+
+  const auto serial_cost {workspace.getDistance(occupancy_grid.getIndex(goal))};
+
+  std::cout << label << ": planPath " << serial_time * 1e3 << " ms, cost " << Cost::toFloat(serial_cost) << '\n';
+
+  project2::BidirectionalWorkspace<Distance> bidirectional_workspace {occupancy_grid.size()};
+
+  for (const bool use_second_thread: {false, true}) {
+    double time {1e9};
+    project2::BidirectionalSearchStats stats {};
+
+    for (unsigned int i {0}; i < repeats; i++) {
+      bench::Timer timer {};
+      project2::planPathBidirectional<project2::EightConnected, project2::GridSpec,
+        project2::RowMajorLayout<project2::GridSpec>, Cost>(start, goal, occupancy_grid, bidirectional_workspace,
+        use_second_thread, clearance_cost, &stats);
+      time = std::min(time, timer.seconds());
+    }
+
+    const auto cost {bidirectional_workspace.getCost()};
+
+    // Float sums of the two halves round differently than one sum from the start
+    const bool same_cost {cost == serial_cost || (std::is_floating_point_v<Distance>
+      && std::abs(Cost::toFloat(cost) - Cost::toFloat(serial_cost)) <= 1e-5F * Cost::toFloat(serial_cost))};
+
+    std::cout << "  " << (use_second_thread ? "two threads: " : "one thread:  ") << time * 1e3 << " ms, cost "
+      << Cost::toFloat(cost) << (same_cost ? "" : " (DIFFERS)") << ", "
+      << stats.forward_expansions << " + " << stats.backward_expansions << " expansions, "
+      << bidirectional_workspace.getPath().size() << " path cells\n";
+  }
+}
+
+}
+
+int main()
+{
+  std::cout << std::thread::hardware_concurrency() << " hardware threads\n";
+
+  auto grid_spec {bench::makeProjectGridSpec()};
+  project2::OccupancyGrid occupancy_grid {bench::makeProjectObstacles(grid_spec), grid_spec};
+  project2::DistanceField distance_field {occupancy_grid};
+
+  runQuery<project2::FloatCost>("Across the map", {60, 60}, {1150, 250}, occupancy_grid, nullptr);
+  runQuery<project2::FloatCost>("Across the map, clearance cost", {60, 60}, {1150, 250}, occupancy_grid,
+    &distance_field);
+  runQuery<project2::FixedPointCost<>>("Across the map, fixed-point", {60, 60}, {1150, 250}, occupancy_grid,
+    nullptr);
+  runQuery<project2::FloatCost>("Short query", {60, 60}, {225, 300}, occupancy_grid, nullptr);
+  runQuery<project2::FloatCost>("Into the C obstacle", {600, 480}, {1000, 250}, occupancy_grid, nullptr);
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file bench_clearance_cost.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Compares the plain and the clearance-aware cost modes
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cstdlib>
+#include <algorithm>
+
+#include "bench_common.hpp"
+
+namespace {
+
+void runSearch(
+  const char * label,
+  const project2::Position& start,
+  const project2::Position& goal,
+  const project2::OccupancyGrid& occupancy_grid,
+  const project2::DistanceField& distance_field,
+  const project2::DistanceField* clearance_cost)
+{
+  auto start_node {project2::Node(start)};
+  auto goal_node {project2::Node(goal)};
+
+  project2::SpscRingBuffer<TwoDE::vec2ui> explored_nodes {occupancy_grid.size()};
+  std::deque<TwoDE::vec2ui> backtracked_path {};
+  std::atomic<bool> search_complete {false};
+
+  bench::Timer timer {};
+  project2::searchDijkstra(start_node, goal_node, occupancy_grid, explored_nodes,
+    backtracked_path, project2::SearchLimits {}, search_complete, clearance_cost);
+  double exec_time {timer.seconds()};
+
+  float min_clearance {1e9F};
+  float mean_clearance {0.F};
+  for (const auto& point: backtracked_path) {
+    float clearance {distance_field.getDistance({point.x, point.y})};
+    min_clearance = std::min(min_clearance, clearance);
+    mean_clearance += clearance;
+  }
+
+  if (!backtracked_path.empty())
+    mean_clearance /= backtracked_path.size();
+
+  std::cout << label << ": "
+    << exec_time << " s, "
+    << explored_nodes.size() << " expansions, "
+    << backtracked_path.size() << " path cells, "
+    << "min clearance " << min_clearance << " mm, "
+    << "mean clearance " << mean_clearance << " mm" << '\n';
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+  project2::Position start {60, 60};
+  project2::Position goal {225, 300};
+
+  if (argc == 5) {
+    start = {static_cast<unsigned int>(std::atoi(argv[1])), static_cast<unsigned int>(std::atoi(argv[2]))};
+    goal = {static_cast<unsigned int>(std::atoi(argv[3])), static_cast<unsigned int>(std::atoi(argv[4]))};
+  }
+
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+
+  bench::Timer timer {};
+  project2::DistanceField distance_field {occupancy_grid};
+  std::cout << "Distance field build: " << timer.seconds() << " s" << '\n';
+
+  runSearch("plain", start, goal, occupancy_grid, distance_field, nullptr);
+  runSearch("clearance", start, goal, occupancy_grid, distance_field, &distance_field);
+
+  return 0;
+}
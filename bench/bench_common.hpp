@@ -0,0 +1,60 @@
+/**
+ * @file bench_common.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Shared map layout and timing helpers for the search benchmarks
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "project2.hpp"
+
+namespace bench {
+
+// Same map as the one in main.cpp
+inline project2::GridSpec makeProjectGridSpec()
+{
+  return {1200, 500};
+}
+
+inline project2::ObstacleList makeProjectObstacles(
+  const project2::GridSpec& grid_spec = makeProjectGridSpec(),
+  unsigned int clearance = 5)
+{
+  std::vector<unsigned int> obstacle3_points {};
+  TwoDE::generatePolygonPoints(obstacle3_points, {650, 250}, 6, 150, true, false);
+
+  return {
+    std::make_shared<project2::ObstacleSpace>(
+      std::vector<unsigned int> {100, 100, 175, 100, 175, 500, 100, 500}, clearance, grid_spec),
+    std::make_shared<project2::ObstacleSpace>(
+      std::vector<unsigned int> {275, 0, 350, 0, 350, 400, 275, 400}, clearance, grid_spec),
+    std::make_shared<project2::ObstacleSpace>(obstacle3_points, clearance, grid_spec),
+    std::make_shared<project2::ObstacleSpace>(
+      std::vector<unsigned int> {
+        900, 50, 1100, 50, 1100, 450, 900, 450, 900, 375, 1020, 375, 1020, 125, 900, 125},
+      clearance, grid_spec)};
+}
+
+class Timer
+{
+  public:
+    Timer() : t_begin_ {std::chrono::steady_clock::now()} {}
+
+    double seconds() const
+    {
+      std::chrono::duration<double> elapsed {std::chrono::steady_clock::now() - t_begin_};
+      return elapsed.count();
+    }
+
+  private:
+    std::chrono::steady_clock::time_point t_begin_;
+};
+
+}
@@ -0,0 +1,71 @@
+/**
+ * @file bench_components.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Unreachable goal: component check vs draining the open list
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+
+  // Wall across the opening of the U, the pocket inside is sealed off
+  obstacles.push_back(std::make_shared<project2::ObstacleSpace>(
+    std::vector<unsigned int> {880, 100, 900, 100, 900, 400, 880, 400}, 5, grid_spec));
+
+  bench::Timer build_timer {};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+  double build_time {build_timer.seconds()};
+
+  const project2::Position start {60, 60};
+  const project2::Position enclosed_goal {960, 250};
+  const project2::Position open_goal {1150, 250};
+
+  std::cout << "Occupancy grid with components: " << build_time << " s, "
+    << occupancy_grid.getComponentCount() << " components, start in "
+    << occupancy_grid.getComponent(start) << ", enclosed goal in "
+    << occupancy_grid.getComponent(enclosed_goal) << '\n';
+
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+
+  bench::Timer reject_timer {};
+  bool found {project2::planPath<project2::EightConnected>(start, enclosed_goal, occupancy_grid, workspace)
+    == project2::SearchStatus::FOUND};
+  double reject_time {reject_timer.seconds()};
+
+  std::cout << "Enclosed goal, component check: " << reject_time * 1e6 << " us"
+    << (found ? " (path found?)" : "") << '\n';
+
+  // Same search without the component check: the sparse search only sees
+  // the free cells
+  auto is_free {[&](const project2::CellCoord& cell) {
+    return !occupancy_grid.isBlocked(cell.x, cell.y);
+  }};
+  project2::SparsePlannerWorkspace sparse_workspace {};
+
+  bench::Timer drain_timer {};
+  found = project2::planPathSparse<project2::EightConnected>({start.x, start.y}, {enclosed_goal.x, enclosed_goal.y},
+    is_free, sparse_workspace);
+  double drain_time {drain_timer.seconds()};
+
+  std::cout << "Enclosed goal, drained open list (sparse search): " << drain_time * 1e6 << " us, "
+    << sparse_workspace.size() << " cells reached" << (found ? " (path found?)" : "") << '\n';
+
+  bench::Timer open_timer {};
+  found = project2::planPath<project2::EightConnected>(start, open_goal, occupancy_grid, workspace)
+    == project2::SearchStatus::FOUND;
+  double open_time {open_timer.seconds()};
+
+  std::cout << "Reachable goal: " << open_time * 1e6 << " us, path cost "
+    << (found ? workspace.getDistance(occupancy_grid.getIndex(open_goal)) : -1.F) << '\n';
+
+  return 0;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file bench_explored_channel.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Explored cell channel: SPSC ring vs a locked deque, and the search
+ * with a renderer attached
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <mutex>
+#include <thread>
+#include <iterator>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+
+namespace {
+
+// Straightforward fix of the old channel, for comparison
+class LockedDeque
+{
+  public:
+    void push(const TwoDE::vec2ui& value)
+    {
+      std::lock_guard<std::mutex> lock {mutex_};
+      values_.push_back(value);
+    }
+
+    unsigned long popBatch(std::deque<TwoDE::vec2ui>& out)
+    {
+      std::lock_guard<std::mutex> lock {mutex_};
+      const auto count {values_.size()};
+
+      out.insert(out.end(), values_.begin(), values_.end());
+      values_.clear();
+
+      return count;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::deque<TwoDE::vec2ui> values_;
+};
+
+// Producer rate with a consumer that drains in batches as fast as it can
+template <typename Push, typename Pop>
+double measureChannel(unsigned long count, Push&& push, Pop&& pop)
+{
+  std::atomic<bool> producing {true};
+  unsigned long popped {0};
+
+  std::thread consumer {[&]() {
+    std::deque<TwoDE::vec2ui> batch {};
+
+    while (producing.load(std::memory_order_acquire) || popped < count) {
+      const auto batch_count {pop(batch)};
+      popped += batch_count;
+      batch.clear();
+
+      if (batch_count == 0)
+        std::this_thread::yield();
+    }
+  }};
+
+  bench::Timer timer {};
+  for (unsigned long i {0}; i < count; i++)
+    push(TwoDE::vec2ui(static_cast<unsigned int>(i), 0U));
+  double push_time {timer.seconds()};
+
+  producing.store(false, std::memory_order_release);
+  consumer.join();
+
+  return count / push_time;
+}
+
+// Search with a renderer thread popping once per frame_period
+double measureSearch(
+  const project2::OccupancyGrid& occupancy_grid,
+  const project2::Position& goal,
+  std::chrono::microseconds frame_period,
+  bool attach_renderer,
+  unsigned long& explored,
+  unsigned long& dropped)
+{
+  auto start_node {project2::Node({60, 60})};
+  auto goal_node {project2::Node(goal)};
+
+  project2::SpscRingBuffer<TwoDE::vec2ui> explored_nodes {occupancy_grid.size()};
+  std::deque<TwoDE::vec2ui> backtracked_path {};
+  std::atomic<bool> search_complete {false};
+  std::atomic<bool> searching {true};
+
+  explored = 0;
+
+  std::thread renderer {[&]() {
+    std::deque<TwoDE::vec2ui> rendered_nodes {};
+
+    while (attach_renderer && searching.load(std::memory_order_acquire)) {
+      explored += explored_nodes.popBatch(std::back_inserter(rendered_nodes));
+      rendered_nodes.clear();
+      std::this_thread::sleep_for(frame_period);
+    }
+  }};
+
+  bench::Timer timer {};
+  project2::searchGrid<project2::EightConnected>(start_node, goal_node, occupancy_grid,
+    explored_nodes, backtracked_path, project2::SearchLimits {}, search_complete);
+  double search_time {timer.seconds()};
+
+  searching.store(false, std::memory_order_release);
+  renderer.join();
+
+  explored += explored_nodes.size();
+  dropped = explored_nodes.getDroppedCount();
+
+  return search_time;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+  const unsigned long count {argc > 1 ? std::stoul(argv[1]) : 20000000UL};
+
+  project2::SpscRingBuffer<TwoDE::vec2ui> ring {1UL << 16};
+  double ring_rate {measureChannel(count,
+    [&](const TwoDE::vec2ui& value) {
+      while (!ring.tryPush(value))
+        std::this_thread::yield();
+    },
+    [&](std::deque<TwoDE::vec2ui>& batch) {return ring.popBatch(std::back_inserter(batch));})};
+
+  LockedDeque locked_deque {};
+  double deque_rate {measureChannel(count,
+    [&](const TwoDE::vec2ui& value) {locked_deque.push(value);},
+    [&](std::deque<TwoDE::vec2ui>& batch) {return locked_deque.popBatch(batch);})};
+
+  std::cout << "Channel, " << count << " pushes, " << std::thread::hardware_concurrency()
+    << " hardware threads: SPSC ring " << ring_rate / 1e6 << " M/s, locked deque "
+    << deque_rate / 1e6 << " M/s\n";
+
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+
+  const project2::Position goal {1150, 250};
+  unsigned long explored {0};
+  unsigned long dropped {0};
+
+  for (const auto& [label, attach, period]: {
+    std::tuple {"no renderer", false, std::chrono::microseconds {0}},
+    std::tuple {"renderer at 60 Hz", true, std::chrono::microseconds {16667}},
+    std::tuple {"renderer at 1 kHz", true, std::chrono::microseconds {1000}}}) {
+    double search_time {measureSearch(occupancy_grid, goal, period, attach, explored, dropped)};
+
+    std::cout << "Search, " << label << ": " << search_time * 1e3 << " ms, "
+      << explored / search_time / 1e6 << " M explored cells/s, " << explored << " explored, "
+      << dropped << " dropped\n";
+  }
+
+  return 0;
+}
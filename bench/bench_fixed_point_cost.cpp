@@ -0,0 +1,91 @@
+/**
+ * @file bench_fixed_point_cost.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Float vs fixed-point path costs: speed and accumulated error
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <iomanip>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+
+namespace {
+
+// Path cost summed in double from the moves of the path
+double exactPathCost(const project2::Position& start, const std::pmr::vector<project2::Position>& path)
+{
+  double cost {0.};
+  project2::Position previous {start};
+
+  for (const auto& position: path) {
+    const bool diagonal {position.x != previous.x && position.y != previous.y};
+    cost += diagonal ? ACTION_COST_DIAGONAL : ACTION_COST_STRAIGHT;
+    previous = position;
+  }
+
+  return cost;
+}
+
+template <typename Cost>
+void runCost(
+  const char * label,
+  const project2::OccupancyGrid& occupancy_grid,
+  const project2::Position& start,
+  const project2::Position& goal)
+{
+  project2::BasicPlannerWorkspace<typename Cost::value_type> workspace {occupancy_grid.size()};
+
+  bench::Timer timer {};
+  project2::planPath<project2::EightConnected, project2::GridSpec,
+    project2::RowMajorLayout<project2::GridSpec>, Cost>(start, goal, occupancy_grid, workspace);
+  double exec_time {timer.seconds()};
+
+  const double cost {Cost::toFloat(workspace.getDistance(occupancy_grid.getIndex(goal)))};
+  const double exact_cost {exactPathCost(start, workspace.getPath())};
+
+  std::cout << "  " << label << ": " << exec_time << " s, path cost " << std::setprecision(10) << cost
+    << ", summed in double " << exact_cost << ", error " << cost - exact_cost << std::setprecision(6) << '\n';
+}
+
+void runMap(
+  const char * label,
+  const project2::ObstacleList& obstacles,
+  const project2::GridSpec& grid_spec,
+  const project2::Position& start,
+  const project2::Position& goal)
+{
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+
+  std::cout << label << '\n';
+  runCost<project2::FloatCost>("float", occupancy_grid, start, goal);
+  runCost<project2::FixedPointCost<10>>("fixed 1/10", occupancy_grid, start, goal);
+  runCost<project2::FixedPointCost<1000>>("fixed 1/1000", occupancy_grid, start, goal);
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  runMap("Project map", bench::makeProjectObstacles(grid_spec), grid_spec, {60, 60}, {1140, 60});
+
+  project2::GridSpec open_spec {6000, 3000};
+  runMap("Open 6000x3000 map", {}, open_spec, {10, 10}, {5990, 2990});
+
+  // Largest cost at 1/4000000 is about 1073, the path costs more than that
+  using SmallRangeCost = project2::FixedPointCost<4000000>;
+  project2::OccupancyGrid occupancy_grid {bench::makeProjectObstacles(grid_spec), grid_spec};
+  project2::BasicPlannerWorkspace<SmallRangeCost::value_type> workspace {occupancy_grid.size()};
+
+  const auto status {project2::planPath<project2::EightConnected, project2::GridSpec,
+    project2::RowMajorLayout<project2::GridSpec>, SmallRangeCost>({60, 60}, {1140, 60}, occupancy_grid, workspace)};
+
+  std::cout << "Path cost beyond the fixed 1/4000000 range: " << project2::toString(status) << '\n';
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file bench_flat_hash_map.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief FlatHashMap vs std::unordered_map as the sparse closed set
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <unordered_map>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+
+namespace {
+
+// The Position hash before the mixing one
+struct LegacyPositionHash {
+  unsigned long operator()(const project2::Position& position) const
+  {
+    return std::hash<int>()(position.x) ^ std::hash<int>()(position.y);
+  }
+};
+
+// Square block of cells far from the origin, like a closed set on a big map
+std::vector<project2::Position> makeKeys(unsigned long count, unsigned int offset)
+{
+  const auto side {static_cast<unsigned int>(std::ceil(std::sqrt(static_cast<double>(count))))};
+  std::vector<project2::Position> keys {};
+  keys.reserve(count);
+
+  for (unsigned int y {0}; y < side && keys.size() < count; y++) {
+    for (unsigned int x {0}; x < side && keys.size() < count; x++)
+      keys.push_back({(1U << 30) + offset + x, (1U << 30) + y});
+  }
+
+  return keys;
+}
+
+template <typename Map>
+void runMap(
+  const char * label,
+  const std::vector<project2::Position>& keys,
+  const std::vector<project2::Position>& missing_keys)
+{
+  Map map {};
+  unsigned long checksum {0};
+
+  bench::Timer insert_timer {};
+  for (unsigned long i {0}; i < keys.size(); i++)
+    map[keys[i]] = static_cast<std::uint32_t>(i);
+  double insert_time {insert_timer.seconds()};
+
+  bench::Timer hit_timer {};
+  for (const auto& key: keys)
+    checksum += map.find(key) != nullptr;
+  double hit_time {hit_timer.seconds()};
+
+  bench::Timer miss_timer {};
+  for (const auto& key: missing_keys)
+    checksum += map.find(key) != nullptr;
+  double miss_time {miss_timer.seconds()};
+
+  const double count {static_cast<double>(keys.size())};
+
+  std::cout << "  " << label << ": insert " << insert_time / count * 1e9 << " ns, hit "
+    << hit_time / count * 1e9 << " ns, miss " << miss_time / count * 1e9 << " ns"
+    << (checksum == keys.size() ? "" : " (wrong lookups)") << '\n';
+}
+
+// Gives std::unordered_map the find() -> pointer interface of FlatHashMap
+template <typename Hash>
+class UnorderedMap : public std::unordered_map<project2::Position, std::uint32_t, Hash>
+{
+  public:
+    const std::uint32_t* find(const project2::Position& key) const
+    {
+      auto found {std::unordered_map<project2::Position, std::uint32_t, Hash>::find(key)};
+      return found == this->end() ? nullptr : &found->second;
+    }
+};
+
+void runSparseSearch()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+
+  // Cells off the map, negative ones included, count as blocked
+  auto is_free {[&](const project2::CellCoord& cell) {
+    return !occupancy_grid.isBlocked(cell.x, cell.y);
+  }};
+
+  project2::SparsePlannerWorkspace sparse_workspace {};
+  project2::PlannerWorkspace dense_workspace {};
+
+  bench::Timer sparse_timer {};
+  project2::planPathSparse<project2::EightConnected>({60, 60}, {225, 300}, is_free, sparse_workspace);
+  double sparse_time {sparse_timer.seconds()};
+
+  bench::Timer dense_timer {};
+  project2::planPath<project2::EightConnected>({60, 60}, {225, 300}, occupancy_grid, dense_workspace);
+  double dense_time {dense_timer.seconds()};
+
+  std::cout << "Sparse search: " << sparse_time << " s, " << sparse_workspace.size() << " nodes, path cost "
+    << sparse_workspace.getDistance(*sparse_workspace.findNode({225, 300})) << '\n';
+  std::cout << "Dense search: " << dense_time << " s, path cost "
+    << dense_workspace.getDistance(occupancy_grid.getIndex({225, 300})) << '\n';
+
+  // Open plane around the origin, moves to negative cells must not wrap
+  auto is_open {[](const project2::CellCoord&) {return true;}};
+
+  project2::planPathSparse<project2::EightConnected>({0, 0}, {3, 0}, is_open, sparse_workspace);
+  const auto near_path_size {sparse_workspace.getPath().size()};
+  const auto near_nodes {sparse_workspace.size()};
+
+  const bool far_found {project2::planPathSparse<project2::EightConnected>({0, 0}, {4294967295L, 0}, is_open,
+    sparse_workspace, 1000)};
+
+  std::cout << "Open plane from the origin: 3 cells away " << near_path_size << " path cells, "
+    << near_nodes << " nodes, 2^32 - 1 cells away " << (far_found ? "found (wrapped?)" : "not found after 1000 expansions")
+    << '\n';
+}
+
+}
+
+// Optional argument: largest entry count, 100000000 needs ~6 GB for the
+// unordered_map
+int main(int argc, char ** argv)
+{
+  const unsigned long max_count {argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000UL};
+
+  for (unsigned long count: {100000UL, 1000000UL, 10000000UL, 100000000UL}) {
+    if (count > max_count)
+      break;
+
+    auto keys {makeKeys(count, 0)};
+    auto missing_keys {makeKeys(count, 1U << 20)};
+
+    std::cout << count << " entries" << '\n';
+
+    if (count <= 100000UL)
+      runMap<UnorderedMap<LegacyPositionHash>>("unordered_map, x ^ y hash", keys, missing_keys);
+
+    runMap<UnorderedMap<std::hash<project2::Position>>>("unordered_map", keys, missing_keys);
+    runMap<project2::FlatHashMap<project2::Position, std::uint32_t>>("FlatHashMap", keys, missing_keys);
+  }
+
+  runSparseSearch();
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file bench_flow_field.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief One flow field against a search per agent, and the bulk agent step
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cmath>
+#include <random>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+#include "flow_field.hpp"
+
+namespace {
+
+using Field = project2::FlowField<project2::EightConnected>;
+
+// Cost of following the field from start, added up in planPath's order
+float walkField(const Field& field, const project2::RowMajorLayout<project2::GridSpec>& layout,
+  unsigned long index, const project2::DistanceField* clearance_cost, unsigned long& steps)
+{
+  float cost {0.F};
+  steps = 0;
+
+  while (field.hasMove(index)) {
+    const auto move {field.getMove(index)};
+    index = layout.getNeighbor(index, layout.getCellX(index), layout.getCellY(index),
+      project2::EightConnected::dx[move], project2::EightConnected::dy[move]);
+
+    cost += project2::EightConnected::cost[move];
+    if (clearance_cost != nullptr)
+      cost += clearance_cost->getPenalty(index);
+
+    steps++;
+  }
+
+  return index == field.getGoalIndex() ? cost : -1.F;
+}
+
+void runAgents(
+  const char* label,
+  const std::vector<project2::Position>& agents,
+  const project2::Position& goal,
+  const project2::OccupancyGrid& occupancy_grid,
+  const project2::DistanceField* clearance_cost)
+{
+  const project2::RowMajorLayout<project2::GridSpec> layout {occupancy_grid.getGridSpec()};
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+  std::vector<float> costs (agents.size());
+
+  bench::Timer search_timer {};
+  for (std::size_t i {0}; i < agents.size(); i++) {
+    project2::planPath<project2::EightConnected>(agents[i], goal, occupancy_grid, workspace, clearance_cost);
+    costs[i] = workspace.getDistance(occupancy_grid.getIndex(goal));
+  }
+  const double search_time {search_timer.seconds()};
+
+  Field field {occupancy_grid};
+  double build_time {1e9};
+  for (unsigned int i {0}; i < 3; i++) {
+    bench::Timer timer {};
+    field.build(goal, clearance_cost);
+    build_time = std::min(build_time, timer.seconds());
+  }
+
+  unsigned int mismatches {0};
+  unsigned long total_steps {0};
+  for (std::size_t i {0}; i < agents.size(); i++) {
+    unsigned long steps {0};
+    const float cost {walkField(field, layout, occupancy_grid.getIndex(agents[i]), clearance_cost, steps)};
+    total_steps += steps;
+
+    if (!(std::abs(cost - costs[i]) <= 1e-4F * costs[i]))
+      mismatches++;
+  }
+
+  std::cout << label << ", " << agents.size() << " agents: " << agents.size() << " planPath calls "
+    << search_time * 1e3 << " ms, one field " << build_time * 1e3 << " ms (" << search_time / build_time
+    << "x), " << total_steps / agents.size() << " steps per agent on average, " << mismatches
+    << " costs that differ from planPath\n";
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  project2::OccupancyGrid occupancy_grid {bench::makeProjectObstacles(grid_spec), grid_spec};
+  project2::DistanceField distance_field {occupancy_grid};
+
+  const project2::Position goal {1150, 250};
+
+  std::mt19937 generator {11};
+  std::uniform_int_distribution<unsigned int> x_distribution {0, grid_spec.width};
+  std::uniform_int_distribution<unsigned int> y_distribution {0, grid_spec.height};
+
+  auto makeAgents {[&](std::size_t count) {
+    std::vector<project2::Position> agents {};
+
+    while (agents.size() < count) {
+      const project2::Position agent {x_distribution(generator), y_distribution(generator)};
+
+      if (occupancy_grid.isConnected(occupancy_grid.getIndex(agent), occupancy_grid.getIndex(goal)))
+        agents.push_back(agent);
+    }
+
+    return agents;
+  }};
+
+  runAgents("Plain", makeAgents(200), goal, occupancy_grid, nullptr);
+  runAgents("Clearance cost", makeAgents(50), goal, occupancy_grid, &distance_field);
+
+  // Fleet moving in lockstep, one stepAgents call per tick
+  Field field {occupancy_grid};
+  field.build(goal);
+
+  for (const std::size_t agent_count: {1000UL, 10000UL, 100000UL}) {
+    const auto agents {makeAgents(agent_count)};
+    std::vector<unsigned int> agent_x (agent_count);
+    std::vector<unsigned int> agent_y (agent_count);
+
+    for (std::size_t i {0}; i < agent_count; i++) {
+      agent_x[i] = agents[i].x;
+      agent_y[i] = agents[i].y;
+    }
+
+    unsigned int ticks {0};
+    std::size_t arrived {0};
+
+    bench::Timer timer {};
+    while (arrived < agent_count && ticks < 5000) {
+      field.stepAgents(agent_x, agent_y);
+      ticks++;
+
+      // Checked every 64 ticks to keep the count out of the timing
+      if (ticks % 64 == 0) {
+        arrived = 0;
+        for (std::size_t i {0}; i < agent_count; i++)
+          arrived += agent_x[i] == goal.x && agent_y[i] == goal.y;
+      }
+    }
+    const double time {timer.seconds()};
+
+    std::cout << agent_count << " agents: " << ticks << " ticks, " << time / ticks * 1e6 << " us per tick, "
+      << time / ticks / agent_count * 1e9 << " ns per agent step, " << arrived << " arrived\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file bench_grid_layout.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Row-major vs tiled Z-order cell arrays on large maps
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cstdlib>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+
+// 3x3 round pillars, the search has to go around most of them
+project2::ObstacleList makePillars(const project2::GridSpec& grid_spec)
+{
+  project2::ObstacleList obstacles {};
+  const unsigned int size {grid_spec.width};
+
+  for (unsigned int row {1}; row <= 3; row++) {
+    for (unsigned int column {1}; column <= 3; column++) {
+      obstacles.push_back(std::make_shared<project2::CircleObstacle>(
+        TwoDE::vec2ui {column * size / 4, row * size / 4}, size / 10, 5, grid_spec));
+    }
+  }
+
+  return obstacles;
+}
+
+template <typename Layout>
+void runLayout(
+  const char * label,
+  const project2::ObstacleList& obstacles,
+  const project2::GridSpec& grid_spec)
+{
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec, Layout::kind};
+  project2::PlannerWorkspace workspace {Layout {grid_spec}.getStorageSize()};
+
+  const unsigned int margin {grid_spec.width / 20};
+  project2::Position start {margin, margin};
+  project2::Position goal {grid_spec.width - margin, grid_spec.height - margin};
+
+  bench::PerfCounters counters {};
+  counters.start();
+  bench::Timer timer {};
+
+  bool found {project2::planPath<project2::EightConnected, project2::GridSpec, Layout>(
+    start, goal, occupancy_grid, workspace) == project2::SearchStatus::FOUND};
+
+  double exec_time {timer.seconds()};
+  counters.stop();
+
+  const auto goal_index {occupancy_grid.getIndex(goal)};
+
+  std::cout << "  " << label << ": " << exec_time << " s, L1D misses "
+    << counters.read(bench::PerfCounters::L1D_READ_MISSES) << ", LLC misses "
+    << counters.read(bench::PerfCounters::LLC_READ_MISSES) << ", path cost "
+    << (found ? workspace.getDistance(goal_index) : -1.F) << '\n';
+}
+
+}
+
+// Optional argument: largest map side to run, e.g. 20000 on a machine with
+// enough memory for the 20k x 20k workspace (~4.5 GB)
+int main(int argc, char ** argv)
+{
+  const unsigned long max_size {argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000UL};
+
+  for (unsigned int size: {1000U, 2000U, 5000U, 10000U, 20000U}) {
+    if (size > max_size)
+      break;
+
+    project2::GridSpec grid_spec {size, size};
+    auto obstacles {makePillars(grid_spec)};
+
+    std::cout << size << "x" << size << '\n';
+    runLayout<project2::RowMajorLayout<project2::GridSpec>>("row-major", obstacles, grid_spec);
+    runLayout<project2::TiledLayout<project2::GridSpec>>("tiled Z-order", obstacles, grid_spec);
+  }
+
+  return 0;
+}
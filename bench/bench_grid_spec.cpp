@@ -0,0 +1,88 @@
+/**
+ * @file bench_grid_spec.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Runtime GridSpec vs the compile-time FixedGridSpec fast path
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+
+namespace {
+
+// Visits every cell by position like the search does for each expansion
+template <typename Spec>
+double sweepGrid(const project2::OccupancyGrid& occupancy_grid, unsigned long& checksum)
+{
+  const Spec grid_spec {occupancy_grid.getGridSpec()};
+  bench::Timer timer {};
+  checksum = 0;
+
+  for (unsigned int y {0}; y <= grid_spec.height; y += grid_spec.cell_size) {
+    for (unsigned int x {0}; x <= grid_spec.width; x += grid_spec.cell_size)
+      checksum += occupancy_grid.getNeighborMask(grid_spec.getIndex({x, y}));
+  }
+
+  return timer.seconds() / grid_spec.getCellCount();
+}
+
+template <unsigned int Size>
+void runSweep()
+{
+  project2::GridSpec grid_spec {Size, Size};
+  project2::ObstacleList obstacles {std::make_shared<project2::CircleObstacle>(
+    TwoDE::vec2ui {Size / 2, Size / 2}, Size / 4, 5, grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+
+  unsigned long runtime_checksum {0};
+  unsigned long fixed_checksum {0};
+  double runtime_time {sweepGrid<project2::GridSpec>(occupancy_grid, runtime_checksum)};
+  double fixed_time {sweepGrid<project2::FixedGridSpec<Size, Size>>(occupancy_grid, fixed_checksum)};
+
+  std::cout << Size << "x" << Size << " sweep: runtime " << runtime_time * 1e9
+    << " ns per cell, fixed " << fixed_time * 1e9 << " ns per cell"
+    << (runtime_checksum == fixed_checksum ? "" : " (checksum mismatch)") << '\n';
+}
+
+template <typename Spec>
+void runSearch(
+  const char * label,
+  const project2::OccupancyGrid& occupancy_grid)
+{
+  auto start_node {project2::Node({60, 60})};
+  auto goal_node {project2::Node({225, 300})};
+
+  project2::SpscRingBuffer<TwoDE::vec2ui> explored_nodes {occupancy_grid.size()};
+  std::deque<TwoDE::vec2ui> backtracked_path {};
+  std::atomic<bool> search_complete {false};
+
+  bench::Timer timer {};
+  project2::searchGrid<project2::EightConnected, Spec>(start_node, goal_node,
+    occupancy_grid, explored_nodes, backtracked_path, project2::SearchLimits {}, search_complete);
+  double exec_time {timer.seconds()};
+
+  std::cout << label << " search: " << exec_time << " s, "
+    << explored_nodes.size() << " expansions, path cost " << goal_node.getDistance() << '\n';
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+
+  runSearch<project2::GridSpec>("runtime", occupancy_grid);
+  runSearch<project2::FixedGridSpec<1200, 500>>("fixed", occupancy_grid);
+
+  runSweep<200>();
+  runSweep<2000>();
+  runSweep<8000>();
+
+  return 0;
+}
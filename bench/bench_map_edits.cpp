@@ -0,0 +1,133 @@
+/**
+ * @file bench_map_edits.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Live obstacle edits: local relabeling vs rebuilding the grid
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <random>
+#include <unordered_map>
+
+#include "bench_common.hpp"
+
+namespace {
+
+// Same partition of the free cells, whatever the IDs are
+bool sameComponents(const project2::OccupancyGrid& edited, const project2::OccupancyGrid& rebuilt)
+{
+  if (edited.getComponentCount() != rebuilt.getComponentCount())
+    return false;
+
+  std::unordered_map<std::uint32_t, std::uint32_t> edited_to_rebuilt {};
+  std::unordered_map<std::uint32_t, std::uint32_t> rebuilt_to_edited {};
+
+  for (unsigned long index {0}; index < edited.size(); index++) {
+    if (edited.isBlocked(index) != rebuilt.isBlocked(index)
+      || edited.getNeighborMask(index) != rebuilt.getNeighborMask(index))
+      return false;
+
+    const auto component {edited.getComponent(index)};
+    const auto other_component {rebuilt.getComponent(index)};
+
+    if (edited_to_rebuilt.try_emplace(component, other_component).first->second != other_component
+      || rebuilt_to_edited.try_emplace(other_component, component).first->second != component)
+      return false;
+  }
+
+  return true;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+  const unsigned int edit_count {argc > 1 ? static_cast<unsigned int>(std::stoul(argv[1])) : 1000U};
+
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+
+  bench::Timer build_timer {};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+  double build_time {build_timer.seconds()};
+
+  std::cout << "Full rebuild: " << build_time * 1e3 << " ms, " << occupancy_grid.getComponentCount() << " components\n";
+
+  // Wall across the opening of the U seals the pocket off and opens it again
+  auto wall {std::make_shared<project2::ObstacleSpace>(
+    std::vector<unsigned int> {880, 100, 900, 100, 900, 400, 880, 400}, 5, grid_spec)};
+  const project2::Position start {60, 60};
+  const project2::Position pocket {960, 250};
+
+  bench::Timer seal_timer {};
+  occupancy_grid.addObstacle(*wall);
+  double seal_time {seal_timer.seconds()};
+  bool sealed {!occupancy_grid.isConnected(occupancy_grid.getIndex(start), occupancy_grid.getIndex(pocket))};
+
+  bench::Timer open_timer {};
+  occupancy_grid.removeObstacle(*wall, obstacles);
+  double open_time {open_timer.seconds()};
+  bool opened {occupancy_grid.isConnected(occupancy_grid.getIndex(start), occupancy_grid.getIndex(pocket))};
+
+  std::cout << "Seal the pocket (split): " << seal_time * 1e3 << " ms" << (sealed ? "" : " (still connected?)")
+    << ", open it (merge): " << open_time * 1e3 << " ms" << (opened ? "" : " (still split?)") << '\n';
+
+  // Random round obstacles dropped and picked up again, a few alive at once
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<unsigned int> x_distribution {20, grid_spec.width - 20};
+  std::uniform_int_distribution<unsigned int> y_distribution {20, grid_spec.height - 20};
+  std::uniform_int_distribution<unsigned int> radius_distribution {5, 40};
+
+  project2::ObstacleList edits {};
+  unsigned int query_hits {0};
+
+  bench::Timer edit_timer {};
+  for (unsigned int edit {0}; edit < edit_count; edit++) {
+    if (edits.size() < 8 || edit % 2 == 0) {
+      edits.push_back(std::make_shared<project2::CircleObstacle>(
+        TwoDE::vec2ui {x_distribution(generator), y_distribution(generator)},
+        radius_distribution(generator), 5, grid_spec));
+      occupancy_grid.addObstacle(*edits.back());
+    }
+    else {
+      auto removed {edits.front()};
+      edits.erase(edits.begin());
+
+      auto remaining {obstacles};
+      remaining.insert(remaining.end(), edits.begin(), edits.end());
+      occupancy_grid.removeObstacle(*removed, remaining);
+    }
+
+    query_hits += occupancy_grid.isConnected(occupancy_grid.getIndex(start), occupancy_grid.getIndex(pocket));
+  }
+  double edit_time {edit_timer.seconds()};
+
+  std::cout << edit_count << " random edits: " << edit_time / edit_count * 1e6 << " us per edit ("
+    << edit_count / edit_time << " edits/s), " << query_hits << " connected queries\n";
+
+  auto all_obstacles {obstacles};
+  all_obstacles.insert(all_obstacles.end(), edits.begin(), edits.end());
+  project2::OccupancyGrid rebuilt {all_obstacles, grid_spec};
+
+  std::cout << "Labels match a full rebuild: " << (sameComponents(occupancy_grid, rebuilt) ? "yes" : "NO") << '\n';
+
+  // First obstacle on an empty map brings the boundary band with it, the
+  // last one takes it away again
+  project2::GridSpec small_spec {200, 100};
+  project2::ObstacleList circle {std::make_shared<project2::CircleObstacle>(TwoDE::vec2ui {100, 50}, 20, 5, small_spec)};
+  project2::OccupancyGrid empty_grid {{}, small_spec};
+
+  empty_grid.addObstacle(*circle.front());
+  const bool first_matches {sameComponents(empty_grid, project2::OccupancyGrid {circle, small_spec})};
+
+  empty_grid.removeObstacle(*circle.front(), {});
+  const bool last_matches {sameComponents(empty_grid, project2::OccupancyGrid {{}, small_spec})};
+
+  std::cout << "First obstacle on an empty map matches a rebuild: " << (first_matches ? "yes" : "NO")
+    << ", last one removed: " << (last_matches ? "yes" : "NO") << '\n';
+
+  return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file bench_neighborhoods.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Per-expansion cost of the 4-, 8- and 16-connected searches
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cstdlib>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+
+namespace {
+
+template <typename Neighborhood>
+void runSearch(
+  const char * label,
+  const project2::Position& start,
+  const project2::Position& goal,
+  const project2::OccupancyGrid& occupancy_grid)
+{
+  auto start_node {project2::Node(start)};
+  auto goal_node {project2::Node(goal)};
+
+  project2::SpscRingBuffer<TwoDE::vec2ui> explored_nodes {occupancy_grid.size()};
+  std::deque<TwoDE::vec2ui> backtracked_path {};
+  std::atomic<bool> search_complete {false};
+
+  bench::Timer timer {};
+  project2::searchGrid<Neighborhood>(start_node, goal_node, occupancy_grid,
+    explored_nodes, backtracked_path, project2::SearchLimits {}, search_complete);
+  double exec_time {timer.seconds()};
+
+  std::cout << label << ": "
+    << explored_nodes.size() << " expansions, "
+    << exec_time / explored_nodes.size() * 1e9 << " ns per expansion, "
+    << "path cost " << goal_node.getDistance() << '\n';
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+  project2::Position start {60, 60};
+  project2::Position goal {225, 300};
+
+  if (argc == 5) {
+    start = {static_cast<unsigned int>(std::atoi(argv[1])), static_cast<unsigned int>(std::atoi(argv[2]))};
+    goal = {static_cast<unsigned int>(std::atoi(argv[3])), static_cast<unsigned int>(std::atoi(argv[4]))};
+  }
+
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+
+  runSearch<project2::FourConnected>("4-connected", start, goal, occupancy_grid);
+  runSearch<project2::EightConnected>("8-connected", start, goal, occupancy_grid);
+  runSearch<project2::SixteenConnected>("16-connected", start, goal, occupancy_grid);
+
+  return 0;
+}
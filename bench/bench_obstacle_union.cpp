@@ -0,0 +1,109 @@
+/**
+ * @file bench_obstacle_union.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Obstacle tests per query point, polygon list vs rasterized union
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <random>
+
+#include "bench_common.hpp"
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+
+  // Heavy overlap: clusters of rectangles and hexagons piled on each other
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<unsigned int> cluster_x {150, 1050};
+  std::uniform_int_distribution<unsigned int> cluster_y {100, 400};
+  std::uniform_int_distribution<unsigned int> jitter {0, 40};
+  std::uniform_int_distribution<unsigned int> extent {20, 60};
+
+  project2::ObstacleList obstacles {};
+
+  for (int cluster {0}; cluster < 12; cluster++) {
+    auto cx {cluster_x(generator)};
+    auto cy {cluster_y(generator)};
+
+    for (int i {0}; i < 10; i++) {
+      auto x {cx + jitter(generator) - 20};
+      auto y {cy + jitter(generator) - 20};
+      auto w {extent(generator)};
+      auto h {extent(generator)};
+
+      if (i % 2 == 0) {
+        obstacles.push_back(std::make_shared<project2::ObstacleSpace>(
+          std::vector<unsigned int> {x - w, y - h, x + w, y - h, x + w, y + h, x - w, y + h},
+          5, grid_spec));
+      }
+      else {
+        std::vector<unsigned int> hexagon_points {};
+        TwoDE::generatePolygonPoints(hexagon_points, {x, y}, 6, w, true, false);
+        obstacles.push_back(std::make_shared<project2::ObstacleSpace>(hexagon_points, 5, grid_spec));
+      }
+    }
+  }
+
+  bench::Timer raster_timer {};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+  double raster_time {raster_timer.seconds()};
+
+  // Tests per query point the same way inObstacleSpace walks the list
+  unsigned long query_count {0};
+  unsigned long polygon_tests {0};
+  unsigned long mismatches {0};
+  unsigned long blocked_cells {0};
+
+  for (unsigned int y {0}; y <= grid_spec.height; y++) {
+    for (unsigned int x {0}; x <= grid_spec.width; x++) {
+      project2::Position position {x, y};
+      bool blocked {false};
+
+      for (auto& obstacle: obstacles) {
+        polygon_tests++;
+
+        if (obstacle->containsPoint(position)) {
+          blocked = true;
+          break;
+        }
+      }
+
+      query_count++;
+      blocked_cells += blocked;
+      mismatches += (blocked != occupancy_grid.isBlocked(position));
+    }
+  }
+
+  bench::Timer polygon_timer {};
+  unsigned long polygon_hits {0};
+  for (unsigned int y {0}; y <= grid_spec.height; y++) {
+    for (unsigned int x {0}; x <= grid_spec.width; x++)
+      polygon_hits += project2::inObstacleSpace({x, y}, obstacles);
+  }
+  double polygon_time {polygon_timer.seconds()};
+
+  bench::Timer lookup_timer {};
+  unsigned long lookup_hits {0};
+  for (unsigned int y {0}; y <= grid_spec.height; y++) {
+    for (unsigned int x {0}; x <= grid_spec.width; x++)
+      lookup_hits += occupancy_grid.isBlocked({x, y});
+  }
+  double lookup_time {lookup_timer.seconds()};
+
+  std::cout << "Obstacles: " << obstacles.size() << ", blocked cells: " << blocked_cells
+    << " / " << query_count << '\n';
+  std::cout << "Union raster build: " << raster_time << " s" << '\n';
+  std::cout << "Polygon list: " << static_cast<double>(polygon_tests) / query_count
+    << " obstacle tests per query, " << polygon_time / query_count * 1e9 << " ns per query" << '\n';
+  std::cout << "Raster union: 1 lookup per query, "
+    << lookup_time / query_count * 1e9 << " ns per query" << '\n';
+  std::cout << "Mismatches: " << mismatches
+    << " (hits " << polygon_hits << " vs " << lookup_hits << ")" << '\n';
+
+  return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file bench_padded_grid.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Bounds checked row-major grid vs the sentinel-padded grid
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+#include "perf_counters.hpp"
+
+namespace {
+
+constexpr unsigned int repeat_count {20};
+
+template <typename Neighborhood, typename Layout>
+void runSearch(
+  const char * label,
+  const project2::ObstacleList& obstacles,
+  const project2::GridSpec& grid_spec)
+{
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec, Layout::kind};
+  project2::PlannerWorkspace workspace {Layout {grid_spec}.getStorageSize()};
+
+  const project2::Position start {60, 60};
+  const project2::Position goal {1140, 60};
+
+  bench::PerfCounters counters {};
+  counters.start();
+  bench::Timer timer {};
+
+  for (unsigned int i {0}; i < repeat_count; i++)
+    project2::planPath<Neighborhood, project2::GridSpec, Layout>(start, goal, occupancy_grid, workspace);
+
+  double exec_time {timer.seconds()};
+  counters.stop();
+
+  unsigned long expansions {0};
+  for (unsigned long index {0}; index < occupancy_grid.size(); index++)
+    expansions += workspace.isClosed(index);
+
+  const double expansion_count {static_cast<double>(expansions) * repeat_count};
+  const long long instructions {counters.read(bench::PerfCounters::INSTRUCTIONS)};
+
+  std::cout << label << ": " << exec_time / expansion_count * 1e9 << " ns per expansion, "
+    << (instructions < 0 ? -1. : instructions / expansion_count) << " instructions per expansion, path cost "
+    << workspace.getDistance(occupancy_grid.getIndex(goal)) << '\n';
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+
+  runSearch<project2::EightConnected, project2::RowMajorLayout<project2::GridSpec>>(
+    "8-connected, row-major", obstacles, grid_spec);
+  runSearch<project2::EightConnected, project2::PaddedLayout<project2::GridSpec>>(
+    "8-connected, padded", obstacles, grid_spec);
+  runSearch<project2::SixteenConnected, project2::RowMajorLayout<project2::GridSpec>>(
+    "16-connected, row-major", obstacles, grid_spec);
+  runSearch<project2::SixteenConnected, project2::PaddedLayout<project2::GridSpec>>(
+    "16-connected, padded", obstacles, grid_spec);
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file bench_parallel_search.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Speedup of the hash-distributed parallel search over planPath
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cmath>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+#include "parallel_search.hpp"
+
+namespace {
+
+// Serpentine maze: walls across the map every spacing cells with the
+// opening at the top and the bottom in turns
+project2::ObstacleList makeMaze(const project2::GridSpec& grid_spec, unsigned int spacing)
+{
+  project2::ObstacleList obstacles {};
+  constexpr unsigned int thickness {4};
+  constexpr unsigned int opening {30};
+
+  for (unsigned int x {spacing}, wall {0}; x + spacing < grid_spec.width; x += spacing, wall++) {
+    const unsigned int y_min {wall % 2 == 0 ? 0 : opening};
+    const unsigned int y_max {wall % 2 == 0 ? grid_spec.height - opening : grid_spec.height};
+
+    obstacles.push_back(std::make_shared<project2::ObstacleSpace>(
+      std::vector<unsigned int> {x, y_min, x + thickness, y_min, x + thickness, y_max, x, y_max}, 2, grid_spec));
+  }
+
+  return obstacles;
+}
+
+void runMap(const char* label, const project2::GridSpec& grid_spec, unsigned int spacing)
+{
+  bench::Timer build_timer {};
+  project2::OccupancyGrid occupancy_grid {makeMaze(grid_spec, spacing), grid_spec};
+  const double build_time {build_timer.seconds()};
+
+  const project2::Position start {10, 10};
+  const project2::Position goal {grid_spec.width - 10, grid_spec.height - 10};
+  const auto goal_index {occupancy_grid.getIndex(goal)};
+
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+
+  double serial_time {1e9};
+  for (unsigned int i {0}; i < 3; i++) {
+    bench::Timer timer {};
+    project2::planPath<project2::EightConnected>(start, goal, occupancy_grid, workspace);
+    serial_time = std::min(serial_time, timer.seconds());
+  }
+  const float serial_cost {workspace.getDistance(goal_index)};
+
+  std::cout << label << " (built in " << build_time << " s): planPath " << serial_time * 1e3 << " ms, cost "
+    << serial_cost << '\n';
+
+  for (const unsigned int thread_count: {1U, 2U, 4U, 8U}) {
+    double parallel_time {1e9};
+    project2::ParallelSearchStats stats {};
+    auto status {project2::SearchStatus::RUNNING};
+
+    for (unsigned int i {0}; i < 3; i++) {
+      bench::Timer timer {};
+      status = project2::planPathParallel<project2::EightConnected>(start, goal, occupancy_grid, workspace,
+        thread_count, nullptr, &stats);
+      parallel_time = std::min(parallel_time, timer.seconds());
+    }
+
+    const float cost {workspace.getDistance(goal_index)};
+
+    std::cout << "  " << thread_count << " threads: " << parallel_time * 1e3 << " ms, speedup "
+      << serial_time / parallel_time << ", " << project2::toString(status) << " cost " << cost
+      << (std::abs(cost - serial_cost) < 1e-3F * serial_cost ? "" : " (DIFFERS)") << ", "
+      << stats.expansions << " expansions, " << stats.reexpansions << " re-expansions, "
+      << stats.messages << " messages\n";
+  }
+}
+
+}
+
+int main()
+{
+  std::cout << std::thread::hardware_concurrency() << " hardware threads\n";
+
+  runMap("Maze 1000x1000", {1000, 1000}, 50);
+  runMap("Maze 2000x2000", {2000, 2000}, 40);
+
+  return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file bench_polygon_decomposition.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Convex decomposition time of comb polygons with many reflex vertices
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <iostream>
+
+#include "bench_common.hpp"
+#include "polygon_decomposition.hpp"
+
+namespace {
+
+// Twice the signed area of a flat point list
+long long getDoubleArea(const project2::PolygonPoints& points)
+{
+  const auto n {points.size() / 2};
+  long long area {0};
+
+  for (unsigned long i {0}; i < n; i++) {
+    const auto j {(i + 1) % n};
+    area += static_cast<long long>(points[2 * i]) * points[2 * j + 1]
+      - static_cast<long long>(points[2 * j]) * points[2 * i + 1];
+  }
+
+  return area;
+}
+
+// Teeth of uneven depth standing on a bar, two reflex vertices per tooth
+project2::PolygonPoints makeComb(unsigned int teeth)
+{
+  constexpr unsigned int tooth_width {4};
+
+  project2::PolygonPoints points {0, 0, 2 * tooth_width * teeth, 0};
+
+  for (unsigned int tooth {teeth}; tooth-- > 0; ) {
+    const unsigned int x {2 * tooth_width * tooth};
+    const unsigned int gap_depth {10 + tooth % 7};
+
+    points.insert(points.end(), {x + 2 * tooth_width, 100, x + tooth_width, 100,
+      x + tooth_width, gap_depth, x, gap_depth});
+  }
+
+  return points;
+}
+
+}
+
+int main()
+{
+  for (const unsigned int teeth: {50U, 200U, 400U, 1000U}) {
+    const auto comb {makeComb(teeth)};
+
+    bench::Timer timer {};
+    const auto pieces {project2::decomposeConvex(comb)};
+    const double time {timer.seconds()};
+
+    long long piece_area {0};
+    bool all_convex {true};
+    for (const auto& piece: pieces) {
+      piece_area += getDoubleArea(piece);
+      all_convex = all_convex && project2::isConvexPolygon(piece);
+    }
+
+    std::cout << comb.size() / 2 << " vertices: " << time * 1e3 << " ms, " << pieces.size() << " pieces, "
+      << (all_convex ? "all convex" : "NOT CONVEX") << ", area "
+      << (piece_area == getDoubleArea(comb) ? "matches" : "DIFFERS") << '\n';
+  }
+
+  return 0;
+}
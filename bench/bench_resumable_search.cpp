@@ -0,0 +1,114 @@
+/**
+ * @file bench_resumable_search.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Retargeted queries from one start, fresh searches against a kept tree
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <random>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+#include "resumable_search.hpp"
+
+namespace {
+
+void runGoals(
+  const char* label,
+  const project2::Position& start,
+  const std::vector<project2::Position>& goals,
+  const project2::OccupancyGrid& occupancy_grid)
+{
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+  std::vector<float> costs (goals.size());
+
+  bench::Timer fresh_timer {};
+  for (std::size_t i {0}; i < goals.size(); i++) {
+    project2::planPath<project2::EightConnected>(start, goals[i], occupancy_grid, workspace);
+    costs[i] = workspace.getDistance(occupancy_grid.getIndex(goals[i]));
+  }
+  const double fresh_time {fresh_timer.seconds()};
+
+  project2::ResumableSearch<project2::EightConnected> search {start, occupancy_grid};
+  unsigned int instant {0};
+  unsigned int mismatches {0};
+
+  bench::Timer resumed_timer {};
+  for (std::size_t i {0}; i < goals.size(); i++) {
+    instant += search.isSettled(goals[i]);
+    search.planPath(goals[i]);
+
+    if (search.getDistance(goals[i]) != costs[i])
+      mismatches++;
+  }
+  const double resumed_time {resumed_timer.seconds()};
+
+  std::cout << label << ", " << goals.size() << " goals: planPath " << fresh_time * 1e3 << " ms, resumed "
+    << resumed_time * 1e3 << " ms (" << fresh_time / resumed_time << "x), " << instant
+    << " answered from the tree, " << search.getExpansions() << " cells settled in total, "
+    << mismatches << " cost mismatches\n";
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+
+  const project2::Position start {60, 60};
+
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<unsigned int> x_distribution {0, grid_spec.width};
+  std::uniform_int_distribution<unsigned int> y_distribution {0, grid_spec.height};
+
+  std::vector<project2::Position> random_goals {};
+  while (random_goals.size() < 200) {
+    const project2::Position goal {x_distribution(generator), y_distribution(generator)};
+
+    if (occupancy_grid.isConnected(occupancy_grid.getIndex(start), occupancy_grid.getIndex(goal)))
+      random_goals.push_back(goal);
+  }
+
+  // An operator dragging the goal along the bottom of the map
+  std::vector<project2::Position> dragged_goals {};
+  for (unsigned int x {200}; x <= 880; x += 4)
+    dragged_goals.push_back({x, 30});
+
+  runGoals("Random goals", start, random_goals, occupancy_grid);
+  runGoals("Dragged goal", start, dragged_goals, occupancy_grid);
+
+  // An edit starts the tree over, the next answer has to match a fresh search
+  project2::ResumableSearch<project2::EightConnected> search {start, occupancy_grid};
+  const project2::Position goal {1150, 250};
+  search.planPath(goal);
+
+  const project2::ObstacleSpace wall {
+    std::vector<unsigned int> {400, 250, 420, 250, 420, 500, 400, 500}, 5, grid_spec};
+  occupancy_grid.addObstacle(wall);
+
+  const bool answered_from_old_tree {search.isSettled(goal)};
+  search.planPath(goal);
+
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+  project2::planPath<project2::EightConnected>(start, goal, occupancy_grid, workspace);
+
+  std::cout << "After an edit: old tree used " << (answered_from_old_tree ? "yes" : "no") << ", cost "
+    << search.getDistance(goal) << " vs planPath "
+    << workspace.getDistance(occupancy_grid.getIndex(goal)) << '\n';
+
+  // A goal off the grid is turned away without losing the tree
+  const project2::Position off_grid {goal.x, 5000};
+  const auto off_grid_status {search.planPath(off_grid)};
+
+  std::cout << "Goal off the grid: " << project2::toString(off_grid_status) << ", settled "
+    << (search.isSettled(off_grid) ? "yes" : "no") << ", tree kept " << (search.isSettled(goal) ? "yes" : "no")
+    << '\n';
+
+  return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file bench_round_obstacles.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Analytic circle obstacles vs the 32-gon approximation
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include "bench_common.hpp"
+
+namespace {
+
+double timeQueries(
+  const project2::ObstacleList& obstacles,
+  const project2::GridSpec& grid_spec,
+  unsigned long& hits)
+{
+  bench::Timer timer {};
+  hits = 0;
+
+  for (unsigned int y {0}; y <= grid_spec.height; y++) {
+    for (unsigned int x {0}; x <= grid_spec.width; x++)
+      hits += project2::inObstacleSpace({x, y}, obstacles);
+  }
+
+  return timer.seconds() / grid_spec.getCellCount();
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+
+  // A hall of round columns
+  project2::ObstacleList polygon_columns {};
+  project2::ObstacleList circle_columns {};
+
+  for (unsigned int y {60}; y <= 440; y += 95) {
+    for (unsigned int x {60}; x <= 1140; x += 90) {
+      std::vector<unsigned int> column_points {};
+      TwoDE::generateEllipsePoints(column_points, {x, y}, 20, 20, 0.F, 32, false);
+
+      polygon_columns.push_back(std::make_shared<project2::ObstacleSpace>(column_points, 5, grid_spec));
+      circle_columns.push_back(std::make_shared<project2::CircleObstacle>(
+        TwoDE::vec2ui {x, y}, 20, 5, grid_spec));
+    }
+  }
+
+  unsigned long polygon_hits {0};
+  unsigned long circle_hits {0};
+  double polygon_time {timeQueries(polygon_columns, grid_spec, polygon_hits)};
+  double circle_time {timeQueries(circle_columns, grid_spec, circle_hits)};
+
+  std::cout << "Columns: " << circle_columns.size() << '\n';
+  std::cout << "32-gon columns: " << polygon_time * 1e9 << " ns per query, "
+    << polygon_hits << " blocked cells" << '\n';
+  std::cout << "Circle columns: " << circle_time * 1e9 << " ns per query, "
+    << circle_hits << " blocked cells" << '\n';
+
+  return 0;
+}
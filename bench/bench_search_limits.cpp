@@ -0,0 +1,116 @@
+/**
+ * @file bench_search_limits.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Cost of checking the search limits, and what each limit returns
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <thread>
+#include <cmath>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+
+namespace {
+
+const project2::Position start {60, 60};
+const project2::Position goal {1150, 250};
+
+// Best of a few runs, the machine is noisy
+double timeSearch(
+  const project2::OccupancyGrid& occupancy_grid,
+  project2::PlannerWorkspace& workspace,
+  const project2::SearchLimits& limits)
+{
+  double best_time {1e9};
+
+  for (unsigned int i {0}; i < 20; i++) {
+    bench::Timer timer {};
+    project2::planPath<project2::EightConnected>(start, goal, occupancy_grid, workspace, nullptr, nullptr, limits);
+    best_time = std::min(best_time, timer.seconds());
+  }
+
+  return best_time;
+}
+
+void report(
+  const char* label,
+  project2::SearchStatus status,
+  double exec_time,
+  const project2::Position& target,
+  const project2::PlannerWorkspace& workspace)
+{
+  const auto& path {workspace.getPath()};
+  const auto end {path.empty() ? start : path.back()};
+
+  std::cout << label << ": " << project2::toString(status) << " after " << exec_time * 1e3 << " ms, partial path of "
+    << path.size() << " cells ends " << std::hypot(float(end.x) - target.x, float(end.y) - target.y)
+    << " mm from the goal\n";
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+
+  std::atomic<bool> stop_search {false};
+
+  project2::SearchLimits checked {&stop_search, project2::SearchLimits::Clock::now() + std::chrono::hours {1}};
+  project2::SearchLimits every_expansion {checked};
+  every_expansion.check_interval = 1;
+
+  double unlimited_time {timeSearch(occupancy_grid, workspace, {})};
+  double checked_time {timeSearch(occupancy_grid, workspace, checked)};
+  double every_time {timeSearch(occupancy_grid, workspace, every_expansion)};
+
+  std::cout << "No limits: " << unlimited_time * 1e3 << " ms, token and deadline every "
+    << SEARCH_CHECK_INTERVAL << " expansions: " << checked_time * 1e3 << " ms, every expansion: "
+    << every_time * 1e3 << " ms\n";
+
+  project2::SearchLimits budget {};
+  budget.max_expansions = 100000;
+
+  bench::Timer timer {};
+  auto status {project2::planPath<project2::EightConnected>(start, goal, occupancy_grid, workspace, nullptr, nullptr, budget)};
+  report("100k expansions", status, timer.seconds(), goal, workspace);
+
+  project2::SearchLimits deadline {};
+  deadline.deadline = project2::SearchLimits::Clock::now() + std::chrono::milliseconds {5};
+
+  timer = {};
+  status = project2::planPath<project2::EightConnected>(start, goal, occupancy_grid, workspace, nullptr, nullptr, deadline);
+  report("5 ms deadline", status, timer.seconds(), goal, workspace);
+
+  std::thread canceller {[&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds {10});
+    stop_search.store(true, std::memory_order_relaxed);
+  }};
+
+  timer = {};
+  status = project2::planPath<project2::EightConnected>(start, goal, occupancy_grid, workspace, nullptr, nullptr, checked);
+  double cancel_time {timer.seconds()};
+  canceller.join();
+  report("Cancelled after 10 ms", status, cancel_time, goal, workspace);
+
+  // Token still set, nothing may be settled
+  timer = {};
+  status = project2::planPath<project2::EightConnected>(start, goal, occupancy_grid, workspace, nullptr, nullptr, checked);
+  report("Cancelled before the start", status, timer.seconds(), goal, workspace);
+
+  // Goal inside an obstacle, no component holds it
+  const project2::Position blocked_goal {130, 300};
+
+  timer = {};
+  status = project2::planPath<project2::EightConnected>(start, blocked_goal, occupancy_grid, workspace);
+  report("Goal in an obstacle", status, timer.seconds(), blocked_goal, workspace);
+
+  return 0;
+}
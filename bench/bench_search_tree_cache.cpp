@@ -0,0 +1,120 @@
+/**
+ * @file bench_search_tree_cache.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Queries from a few repeated sources, planPath against cached trees
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <random>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+#include "search_tree_cache.hpp"
+
+namespace {
+
+struct Query {
+  project2::Position start;
+  project2::Position goal;
+};
+
+void runQueries(
+  const char* label,
+  const std::vector<Query>& queries,
+  const project2::OccupancyGrid& occupancy_grid,
+  const project2::DistanceField* clearance_cost,
+  unsigned long memory_budget)
+{
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+  std::vector<float> costs (queries.size());
+
+  bench::Timer fresh_timer {};
+  for (std::size_t i {0}; i < queries.size(); i++) {
+    project2::planPath<project2::EightConnected>(queries[i].start, queries[i].goal, occupancy_grid, workspace,
+      clearance_cost);
+    costs[i] = workspace.getDistance(occupancy_grid.getIndex(queries[i].goal));
+  }
+  const double fresh_time {fresh_timer.seconds()};
+
+  project2::SearchTreeCache<project2::EightConnected> cache {occupancy_grid, memory_budget};
+  unsigned int mismatches {0};
+
+  bench::Timer cached_timer {};
+  for (std::size_t i {0}; i < queries.size(); i++) {
+    cache.planPath(queries[i].start, queries[i].goal, clearance_cost);
+
+    if (cache.getCost() != costs[i])
+      mismatches++;
+  }
+  const double cached_time {cached_timer.seconds()};
+
+  const auto metrics {cache.getMetrics()};
+
+  std::cout << label << ", " << queries.size() << " queries: planPath " << fresh_time * 1e3 << " ms, cache "
+    << cached_time * 1e3 << " ms (" << fresh_time / cached_time << "x), " << metrics.hits << " hits, "
+    << metrics.misses << " misses, " << metrics.evictions << " evictions, " << metrics.tree_count << " trees in "
+    << metrics.bytes / 1024 << " KiB, " << mismatches << " cost mismatches\n";
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  project2::OccupancyGrid occupancy_grid {bench::makeProjectObstacles(grid_spec), grid_spec};
+  project2::DistanceField distance_field {occupancy_grid};
+
+  // Every query starts at one of the docks
+  const std::vector<project2::Position> docks {
+    {60, 60}, {60, 450}, {225, 300}, {500, 50}, {800, 480}, {1150, 250}, {1150, 20}, {960, 250}};
+
+  std::mt19937 generator {7};
+  std::uniform_int_distribution<std::size_t> dock_distribution {0, docks.size() - 1};
+  std::uniform_int_distribution<unsigned int> x_distribution {0, grid_spec.width};
+  std::uniform_int_distribution<unsigned int> y_distribution {0, grid_spec.height};
+
+  std::vector<Query> queries {};
+  while (queries.size() < 300) {
+    const Query query {docks[dock_distribution(generator)], {x_distribution(generator), y_distribution(generator)}};
+
+    if (occupancy_grid.isConnected(occupancy_grid.getIndex(query.start), occupancy_grid.getIndex(query.goal)))
+      queries.push_back(query);
+  }
+
+  project2::SearchTreeCache<project2::EightConnected> probe {occupancy_grid};
+  probe.planPath(docks.front(), docks.back());
+  const unsigned long tree_bytes {probe.getMetrics().bytes};
+  std::cout << "One tree of the " << grid_spec.width << "x" << grid_spec.height << " map: " << tree_bytes / 1024
+    << " KiB\n";
+
+  runQueries("Plain, all docks fit", queries, occupancy_grid, nullptr, SEARCH_TREE_CACHE_BYTES);
+  runQueries("Clearance cost, all docks fit", queries, occupancy_grid, &distance_field, SEARCH_TREE_CACHE_BYTES);
+  runQueries("Plain, budget of 4 trees", queries, occupancy_grid, nullptr, 4 * tree_bytes);
+
+  // An edit changes the map version, the next query from a cached dock misses
+  project2::SearchTreeCache<project2::EightConnected> cache {occupancy_grid};
+  cache.planPath(docks.front(), docks.back());
+
+  const project2::ObstacleSpace wall {
+    std::vector<unsigned int> {400, 250, 420, 250, 420, 500, 400, 500}, 5, grid_spec};
+  occupancy_grid.addObstacle(wall);
+
+  cache.planPath(docks.front(), docks.back());
+
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+  project2::planPath<project2::EightConnected>(docks.front(), docks.back(), occupancy_grid, workspace);
+
+  std::cout << "After an edit: " << cache.getMetrics().misses << " misses of 2, cost " << cache.getCost()
+    << " vs planPath " << workspace.getDistance(occupancy_grid.getIndex(docks.back())) << '\n';
+
+  const auto off_grid_status {cache.planPath({5000, 60}, docks.back())};
+
+  std::cout << "Start off the grid: " << project2::toString(off_grid_status) << ", "
+    << cache.getMetrics().misses << " misses\n";
+
+  return 0;
+}
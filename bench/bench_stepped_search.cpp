@@ -0,0 +1,240 @@
+/**
+ * @file bench_stepped_search.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Cost of yielding from the search, and many queries on a few threads
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <random>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+#include "stepped_search.hpp"
+#include "search_scheduler.hpp"
+
+namespace {
+
+constexpr unsigned int query_count {200};
+
+const project2::Position start {60, 60};
+const project2::Position goal {1150, 250};
+
+using Query = std::pair<project2::Position, project2::Position>;
+
+// Free start and goal cells anywhere on the map, mostly long queries
+std::vector<Query> makeQueries(const project2::OccupancyGrid& occupancy_grid)
+{
+  const auto& grid_spec {occupancy_grid.getGridSpec()};
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<long> column {0, grid_spec.getColumns() - 1};
+  std::uniform_int_distribution<long> row {0, grid_spec.getRows() - 1};
+
+  std::vector<Query> queries {};
+
+  while (queries.size() < query_count) {
+    const long start_x {column(generator)};
+    const long start_y {row(generator)};
+    const long goal_x {column(generator)};
+    const long goal_y {row(generator)};
+
+    if (occupancy_grid.isBlocked(start_x, start_y) || occupancy_grid.isBlocked(goal_x, goal_y))
+      continue;
+
+    const auto cell_size {grid_spec.cell_size};
+    queries.push_back({
+      {static_cast<unsigned int>(start_x) * cell_size, static_cast<unsigned int>(start_y) * cell_size},
+      {static_cast<unsigned int>(goal_x) * cell_size, static_cast<unsigned int>(goal_y) * cell_size}});
+  }
+
+  return queries;
+}
+
+// Resumes until the last step, returns the number of steps
+unsigned long drain(project2::SearchGenerator& search, project2::SearchStatus& status)
+{
+  unsigned long steps {0};
+
+  while (search.next()) {
+    steps++;
+    status = search.value().status;
+  }
+
+  return steps;
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+  project2::PlannerWorkspace workspace {occupancy_grid.size()};
+  project2::PlannerWorkspace stepped_workspace {occupancy_grid.size()};
+
+  const auto goal_index {grid_spec.getIndex(goal)};
+
+  double direct_time {1e9};
+
+  for (unsigned int i {0}; i < 10; i++) {
+    bench::Timer timer {};
+    project2::planPath<project2::EightConnected>(start, goal, occupancy_grid, workspace);
+    direct_time = std::min(direct_time, timer.seconds());
+  }
+
+  std::cout << "planPath: " << direct_time * 1e3 << " ms, cost " << workspace.getDistance(goal_index) << '\n';
+
+  for (const unsigned long step_expansions: {1UL, 16UL, 256UL, 4096UL, 65536UL}) {
+    double stepped_time {1e9};
+    unsigned long steps {0};
+    unsigned long settled {0};
+    auto status {project2::SearchStatus::RUNNING};
+
+    for (unsigned int i {0}; i < 10; i++) {
+      auto search {project2::planPathSteps<project2::EightConnected>(start, goal, occupancy_grid,
+        stepped_workspace, step_expansions)};
+
+      bench::Timer timer {};
+      steps = 0;
+      settled = 0;
+
+      while (search.next()) {
+        steps++;
+        settled += search.value().settled.size();
+        status = search.value().status;
+      }
+
+      stepped_time = std::min(stepped_time, timer.seconds());
+    }
+
+    const bool same {status == project2::SearchStatus::FOUND
+      && stepped_workspace.getDistance(goal_index) == workspace.getDistance(goal_index)
+      && stepped_workspace.getPath() == workspace.getPath()};
+
+    std::cout << "Stepped every " << step_expansions << " expansions: " << stepped_time * 1e3 << " ms in "
+      << steps << " steps, " << settled << " cells settled, "
+      << (same ? "same path as planPath" : "PATH DIFFERS") << '\n';
+  }
+
+  // Dropping a search halfway leaves the workspace to the next one
+  {
+    auto search {project2::planPathSteps<project2::EightConnected>(start, goal, occupancy_grid,
+      stepped_workspace, 1000)};
+    search.next();
+  }
+
+  auto status {project2::SearchStatus::RUNNING};
+  auto search {project2::planPathSteps<project2::EightConnected>(start, goal, occupancy_grid, stepped_workspace)};
+  drain(search, status);
+  std::cout << "After a dropped search: " << project2::toString(status) << ", cost "
+    << stepped_workspace.getDistance(goal_index) << '\n';
+
+  const auto queries {makeQueries(occupancy_grid)};
+  std::vector<std::unique_ptr<project2::PlannerWorkspace>> workspaces {};
+  std::vector<project2::SearchStatus> statuses (queries.size());
+  std::vector<unsigned long> path_sizes (queries.size());
+
+  for (unsigned int i {0}; i < queries.size(); i++)
+    workspaces.push_back(std::make_unique<project2::PlannerWorkspace>(occupancy_grid.size()));
+
+  bench::Timer sequential_timer {};
+  for (unsigned int i {0}; i < queries.size(); i++) {
+    statuses[i] = project2::planPath<project2::EightConnected>(queries[i].first, queries[i].second,
+      occupancy_grid, *workspaces[i]);
+    path_sizes[i] = workspaces[i]->getPath().size();
+  }
+  const double sequential_time {sequential_timer.seconds()};
+
+  std::cout << '\n' << queries.size() << " queries one after the other: " << sequential_time * 1e3 << " ms\n";
+
+  for (const unsigned int thread_count: {1U, 2U, 4U}) {
+    project2::SearchScheduler scheduler {thread_count};
+    std::vector<double> finish_times (queries.size());
+    std::vector<project2::SearchStatus> scheduled_statuses (queries.size());
+
+    bench::Timer timer {};
+    for (unsigned int i {0}; i < queries.size(); i++) {
+      scheduler.submit(
+        project2::planPathSteps<project2::EightConnected>(queries[i].first, queries[i].second,
+          occupancy_grid, *workspaces[i]),
+        [&, i](const project2::SearchStep& step) {
+          if (step.status != project2::SearchStatus::RUNNING) {
+            scheduled_statuses[i] = step.status;
+            finish_times[i] = timer.seconds();
+          }
+        });
+    }
+
+    scheduler.wait();
+    const double total_time {timer.seconds()};
+
+    unsigned long mismatches {0};
+    for (unsigned int i {0}; i < queries.size(); i++)
+      mismatches += scheduled_statuses[i] != statuses[i] || workspaces[i]->getPath().size() != path_sizes[i];
+
+    std::sort(finish_times.begin(), finish_times.end());
+
+    std::cout << thread_count << " threads, " << queries.size() << " queries in flight: " << total_time * 1e3
+      << " ms, first done after " << finish_times.front() * 1e3 << " ms, median "
+      << finish_times[finish_times.size() / 2] * 1e3 << " ms, " << mismatches << " results differ\n";
+  }
+
+  // A throwing callback ends its own search only
+  {
+    project2::SearchScheduler scheduler {2};
+    auto status {project2::SearchStatus::RUNNING};
+    auto failed_status {project2::SearchStatus::RUNNING};
+
+    scheduler.submit(
+      project2::planPathSteps<project2::EightConnected>(start, goal, occupancy_grid, *workspaces[0]),
+      [&](const project2::SearchStep& step) {
+        if (step.status == project2::SearchStatus::RUNNING)
+          throw std::runtime_error {"callback failed"};
+
+        failed_status = step.status;
+      });
+    scheduler.submit(
+      project2::planPathSteps<project2::EightConnected>(start, goal, occupancy_grid, *workspaces[1]),
+      [&](const project2::SearchStep& step) {status = step.status;});
+
+    scheduler.wait();
+
+    std::cout << "Throwing callback: " << project2::toString(failed_status) << ", " << scheduler.getFailedCount()
+      << " failed, the other search " << project2::toString(status) << '\n';
+  }
+
+  // Destroyed with searches in flight, every callback still hears the end
+  {
+    // Callbacks of different searches run on different workers
+    std::atomic<unsigned long> cancelled {0};
+    std::atomic<unsigned long> ended {0};
+
+    {
+      project2::SearchScheduler scheduler {2};
+
+      for (unsigned int i {0}; i < queries.size(); i++) {
+        scheduler.submit(
+          project2::planPathSteps<project2::EightConnected>(queries[i].first, queries[i].second, occupancy_grid,
+            *workspaces[i]),
+          [&](const project2::SearchStep& step) {
+            cancelled.fetch_add(step.status == project2::SearchStatus::CANCELLED, std::memory_order_relaxed);
+            ended.fetch_add(step.status != project2::SearchStatus::RUNNING, std::memory_order_relaxed);
+          });
+      }
+    }
+
+    std::cout << "Destroyed with " << queries.size() << " in flight: " << ended.load() << " ended, " << cancelled.load()
+      << " cancelled\n";
+  }
+
+  return 0;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file bench_workspace.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Fresh, arena-backed and reused search buffers for many short queries
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <random>
+#include <utility>
+
+#include "allocation_counter.hpp"
+#include "bench_common.hpp"
+#include "grid_search.hpp"
+#include "search_arena.hpp"
+
+namespace {
+
+constexpr unsigned int query_count {5000};
+constexpr unsigned int query_radius {30};
+
+using Query = std::pair<project2::Position, project2::Position>;
+
+// Free start and goal cells a few steps apart, the typical game-style query
+std::vector<Query> makeQueries(const project2::OccupancyGrid& occupancy_grid)
+{
+  const auto& grid_spec {occupancy_grid.getGridSpec()};
+  std::mt19937 generator {42};
+  std::uniform_int_distribution<long> column {0, grid_spec.getColumns() - 1};
+  std::uniform_int_distribution<long> row {0, grid_spec.getRows() - 1};
+  std::uniform_int_distribution<long> offset {-static_cast<long>(query_radius), query_radius};
+
+  std::vector<Query> queries {};
+  queries.reserve(query_count);
+
+  while (queries.size() < query_count) {
+    const long start_x {column(generator)};
+    const long start_y {row(generator)};
+    const long goal_x {start_x + offset(generator)};
+    const long goal_y {start_y + offset(generator)};
+
+    if (occupancy_grid.isBlocked(start_x, start_y) || occupancy_grid.isBlocked(goal_x, goal_y))
+      continue;
+
+    const auto cell_size {grid_spec.cell_size};
+    queries.push_back({
+      {static_cast<unsigned int>(start_x) * cell_size, static_cast<unsigned int>(start_y) * cell_size},
+      {static_cast<unsigned int>(goal_x) * cell_size, static_cast<unsigned int>(goal_y) * cell_size}});
+  }
+
+  return queries;
+}
+
+// plan returns the path length of a query, or -1 if there is no path
+template <typename Plan>
+void runQueries(
+  const char * label,
+  const std::vector<Query>& queries,
+  Plan&& plan)
+{
+  // Warm-up query so reused buffers have grown to the map once
+  plan(queries.front());
+
+  const auto allocations_before {bench::getAllocationCount()};
+  const auto bytes_before {bench::getAllocatedBytes()};
+  unsigned long found {0};
+  double path_length {0.};
+
+  bench::Timer timer {};
+  for (const auto& query: queries) {
+    const long length {plan(query)};
+
+    if (length >= 0) {
+      found++;
+      path_length += length;
+    }
+  }
+  double exec_time {timer.seconds()};
+
+  std::cout << label << ": " << exec_time / queries.size() * 1e6 << " us per query, "
+    << static_cast<double>(bench::getAllocationCount() - allocations_before) / queries.size()
+    << " operator new calls and " << (bench::getAllocatedBytes() - bytes_before) / queries.size()
+    << " bytes per query (" << found << " paths, mean length " << path_length / found << ")" << '\n';
+}
+
+long planPathLength(
+  const Query& query,
+  const project2::OccupancyGrid& occupancy_grid,
+  project2::PlannerWorkspace& workspace)
+{
+  if (project2::planPath<project2::EightConnected>(query.first, query.second, occupancy_grid, workspace)
+    != project2::SearchStatus::FOUND)
+    return -1;
+
+  return static_cast<long>(workspace.getPath().size());
+}
+
+}
+
+int main()
+{
+  auto grid_spec {bench::makeProjectGridSpec()};
+  auto obstacles {bench::makeProjectObstacles(grid_spec)};
+  project2::OccupancyGrid occupancy_grid {obstacles, grid_spec};
+  auto queries {makeQueries(occupancy_grid)};
+
+  std::cout << queries.size() << " queries within " << query_radius << " cells on the "
+    << grid_spec.getColumns() << "x" << grid_spec.getRows() << " map" << '\n';
+
+  runQueries("Fresh workspace", queries, [&](const Query& query) {
+    project2::PlannerWorkspace workspace {grid_spec.getCellCount()};
+    return planPathLength(query, occupancy_grid, workspace);
+  });
+
+  runQueries("Fresh workspace in a search arena", queries, [&](const Query& query) {
+    project2::SearchArena arena {};
+    project2::PlannerWorkspace workspace {grid_spec.getCellCount(), arena.getResource()};
+    return planPathLength(query, occupancy_grid, workspace);
+  });
+
+  project2::PlannerWorkspace workspace {};
+  runQueries("Reused workspace", queries, [&](const Query& query) {
+    return planPathLength(query, occupancy_grid, workspace);
+  });
+
+  return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file perf_counters.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Hardware event counters of the calling thread through perf_event_open
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace bench {
+
+/**
+ * @brief User-space instructions, L1 data read misses and last level cache
+ * read misses. Events the kernel or the machine doesn't allow (containers,
+ * VMs without a PMU) read as -1 instead of failing the benchmark.
+ *
+ */
+class PerfCounters
+{
+  public:
+    enum Event {
+      INSTRUCTIONS = 0,
+      L1D_READ_MISSES = 1,
+      LLC_READ_MISSES = 2
+    };
+
+    PerfCounters()
+    {
+      openCounter(INSTRUCTIONS, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+      openCounter(L1D_READ_MISSES, PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_L1D));
+      openCounter(LLC_READ_MISSES, PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_LL));
+    }
+
+    ~PerfCounters()
+    {
+      for (const auto& fd: fds_) {
+        if (fd >= 0)
+          close(fd);
+      }
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    void start()
+    {
+      for (const auto& fd: fds_) {
+        if (fd >= 0) {
+          ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+          ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+      }
+    }
+
+    void stop()
+    {
+      for (const auto& fd: fds_) {
+        if (fd >= 0)
+          ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+      }
+    }
+
+    long long read(Event event) const
+    {
+      long long count {-1};
+
+      if (fds_[event] < 0 || ::read(fds_[event], &count, sizeof(count)) != sizeof(count))
+        return -1;
+
+      return count;
+    }
+
+  private:
+    static std::uint64_t cacheEvent(std::uint64_t cache)
+    {
+      return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+    void openCounter(Event event, std::uint32_t type, std::uint64_t config)
+    {
+      perf_event_attr attributes {};
+      attributes.size = sizeof(attributes);
+      attributes.type = type;
+      attributes.config = config;
+      attributes.disabled = 1;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+
+      fds_[event] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+
+    std::array<int, 3> fds_ {-1, -1, -1};
+};
+
+}
@@ -0,0 +1,141 @@
+/**
+ * @file async_planner.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Declaration of the asynchronous planning facade on a thread pool
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "grid_search.hpp"
+
+namespace project2 {
+
+// What a single query may spend, nothing is limited by default
+struct PlanOptions {
+  // Counted from planAsync, time spent in the queue included
+  SearchLimits::Clock::duration timeout {SearchLimits::Clock::duration::max()};
+  unsigned long max_expansions {std::numeric_limits<unsigned long>::max()};
+  const DistanceField* clearance_cost {nullptr};
+};
+
+struct PlanResult {
+  SearchStatus status {SearchStatus::RUNNING};
+
+  // Path to the goal, the best partial path unless the goal was found
+  std::vector<Position> path {};
+  float cost {0.F};
+
+  SearchLimits::Clock::duration queue_time {};
+  SearchLimits::Clock::duration run_time {};
+};
+
+/**
+ * @brief Returned by planAsync. The future is fulfilled once the query is
+ * over, whatever its status. cancel() stops the query where it is: a queued
+ * one never starts, a running one stops at its next limit check, and both
+ * complete with CANCELLED.
+ *
+ */
+class PlanHandle
+{
+  public:
+    void cancel() {stop_token_->store(true, std::memory_order_relaxed);}
+
+    std::future<PlanResult>& getFuture() {return future_;}
+    PlanResult get() {return future_.get();}
+
+  private:
+    friend class AsyncPlanner;
+
+    PlanHandle(std::shared_ptr<std::atomic<bool>> stop_token, std::future<PlanResult> future)
+    : stop_token_ {std::move(stop_token)}, future_ {std::move(future)}
+    {}
+
+    std::shared_ptr<std::atomic<bool>> stop_token_;
+    std::future<PlanResult> future_;
+};
+
+struct PlannerMetrics {
+  unsigned long submitted {0};
+  unsigned long completed {0};
+  unsigned long cancelled {0};
+  unsigned long queue_depth {0};
+  unsigned long max_queue_depth {0};
+  SearchLimits::Clock::duration total_queue_time {};
+  SearchLimits::Clock::duration max_queue_time {};
+  SearchLimits::Clock::duration total_run_time {};
+  SearchLimits::Clock::duration max_run_time {};
+};
+
+/**
+ * @brief Plans 8-connected paths on a fixed pool of worker threads. Each
+ * worker keeps one workspace for all of its queries, so a query allocates
+ * nothing but its result once the pool is warm. Queries run in submission
+ * order. The occupancy grid has to stay unchanged while queries are
+ * pending.
+ *
+ * The completion callback runs on the worker, before the future is
+ * fulfilled, and must not block for long. Queries still queued when the
+ * planner is destroyed complete with CANCELLED.
+ *
+ */
+class AsyncPlanner
+{
+  public:
+    using Callback = std::function<void(const PlanResult&)>;
+
+    explicit AsyncPlanner(
+      const OccupancyGrid& occupancy_grid,
+      unsigned int thread_count = std::thread::hardware_concurrency());
+    ~AsyncPlanner();
+
+    AsyncPlanner(const AsyncPlanner&) = delete;
+    AsyncPlanner& operator=(const AsyncPlanner&) = delete;
+
+    PlanHandle planAsync(
+      const Position& start,
+      const Position& goal,
+      const PlanOptions& options = PlanOptions {},
+      Callback on_done = {});
+
+    PlannerMetrics getMetrics() const;
+    unsigned int getThreadCount() const {return static_cast<unsigned int>(workers_.size());}
+
+  private:
+    struct Job {
+      Position start;
+      Position goal;
+      PlanOptions options;
+      SearchLimits::Clock::time_point submit_time;
+      std::shared_ptr<std::atomic<bool>> stop_token;
+      std::promise<PlanResult> promise;
+      Callback on_done;
+    };
+
+    void runWorker();
+    PlanResult runJob(Job& job, PlannerWorkspace& workspace) const;
+
+    const OccupancyGrid& occupancy_grid_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Job> jobs_;
+    PlannerMetrics metrics_;
+    bool stopping_;
+    std::vector<std::thread> workers_;
+};
+}
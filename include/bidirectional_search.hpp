@@ -0,0 +1,332 @@
+/**
+ * @file bidirectional_search.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Bidirectional Dijkstra search with one thread per direction
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "grid_search.hpp"
+
+// Settles between two publications of a direction's key when each direction
+// has its own thread
+#define BIDIRECTIONAL_KEY_INTERVAL 64
+
+namespace project2 {
+
+struct BidirectionalSearchStats {
+  unsigned long forward_expansions {0};
+  unsigned long backward_expansions {0};
+};
+
+/**
+ * @brief Buffers of a bidirectional search: one planner workspace per
+ * direction plus the distances of the settled cells of both directions, which
+ * the other direction's thread reads. Those are stamped with the query's
+ * generation like the workspace entries, so reset() stays O(1).
+ *
+ */
+template <typename Distance>
+class BidirectionalWorkspace
+{
+  public:
+    static constexpr unsigned int forward {0};
+    static constexpr unsigned int backward {1};
+
+    BidirectionalWorkspace() = default;
+    explicit BidirectionalWorkspace(unsigned long cell_count) {reset(cell_count);}
+
+    void reset(unsigned long cell_count)
+    {
+      for (auto& workspace: workspaces_)
+        workspace.reset(cell_count);
+
+      if (cell_count > capacity_) {
+        for (auto& settled: settled_)
+          settled = std::make_unique<std::atomic<std::uint64_t>[]>(cell_count);
+
+        capacity_ = cell_count;
+        generation_ = 0;
+      }
+
+      generation_++;
+
+      // Wrapped around, stamps from 2^32 queries ago would look current
+      if (generation_ == 0) {
+        for (auto& settled: settled_) {
+          for (unsigned long index {0}; index < capacity_; index++)
+            settled[index].store(0, std::memory_order_relaxed);
+        }
+
+        generation_ = 1;
+      }
+
+      cost_ = BasicPlannerWorkspace<Distance>::unreached;
+    }
+
+    BasicPlannerWorkspace<Distance>& getWorkspace(unsigned int direction) {return workspaces_[direction];}
+
+    // Final distance of a cell settled in direction, unreached otherwise
+    Distance getSettled(unsigned int direction, unsigned long index) const
+    {
+      const auto entry {settled_[direction][index].load(std::memory_order_acquire)};
+
+      return static_cast<std::uint32_t>(entry >> 32) == generation_
+        ? std::bit_cast<Distance>(static_cast<std::uint32_t>(entry)) : BasicPlannerWorkspace<Distance>::unreached;
+    }
+
+    void settle(unsigned int direction, unsigned long index, Distance distance)
+    {
+      settled_[direction][index].store((static_cast<std::uint64_t>(generation_) << 32)
+        | std::bit_cast<std::uint32_t>(distance), std::memory_order_release);
+    }
+
+    // Cost of the last path found, unreached if there was none
+    Distance getCost() const {return cost_;}
+    void setCost(Distance cost) {cost_ = cost;}
+
+    std::pmr::vector<Position>& getPath() {return workspaces_[forward].getPath();}
+    const std::pmr::vector<Position>& getPath() const {return workspaces_[forward].getPath();}
+
+  private:
+    static_assert(sizeof(Distance) == sizeof(std::uint32_t));
+
+    std::array<BasicPlannerWorkspace<Distance>, 2> workspaces_;
+    std::array<std::unique_ptr<std::atomic<std::uint64_t>[]>, 2> settled_ {};
+    unsigned long capacity_ {0};
+    std::uint32_t generation_ {0};
+    Distance cost_ {BasicPlannerWorkspace<Distance>::unreached};
+};
+
+using PlannerBidirectionalWorkspace = BidirectionalWorkspace<float>;
+using FixedBidirectionalWorkspace = BidirectionalWorkspace<std::uint32_t>;
+
+/**
+ * @brief planPath searching from the start and from the goal at the same
+ * time, on two threads unless use_second_thread is false, in which case one
+ * thread alternates between the directions, always advancing the one with
+ * the lower key.
+ *
+ * The backward search follows the moves in reverse. The neighborhoods are
+ * symmetric, so a move costs the same both ways, but the clearance penalty
+ * belongs to the cell a move enters: going backward it is the penalty of the
+ * cell being expanded, not of the child.
+ *
+ * Every settled cell is published with its final distance. When a direction
+ * relaxes a move into a cell the other direction has settled, the path
+ * through that move is a candidate, the best candidate cost is shared as an
+ * atomic. Settling stores the cell before looking at its children with a
+ * sequentially consistent fence in between, so of two cells joined by a move
+ * at least one direction sees the other's cell settled. Each direction
+ * publishes the key it is about to settle (release), every
+ * BIDIRECTIONAL_KEY_INTERVAL settles on two threads and whenever it changes
+ * on one. Keys only grow, so a published key is a lower bound of the
+ * current one and the candidates found below it are already in the shared
+ * best cost (acquire). The search stops once its own key and the other
+ * direction's published key add up to the best candidate or more, then no
+ * path can be cheaper and the cost is the one planPath finds. A late key
+ * only delays the stop.
+ *
+ * The path ends up in workspace.getPath(), its cost in workspace.getCost().
+ *
+ */
+template <typename Neighborhood, typename Spec = GridSpec, typename Layout = RowMajorLayout<Spec>,
+  typename Cost = FloatCost>
+SearchStatus planPathBidirectional(
+  const Position& start,
+  const Position& goal,
+  const OccupancyGrid& occupancy_grid,
+  BidirectionalWorkspace<typename Cost::value_type>& workspace,
+  bool use_second_thread = true,
+  const DistanceField* clearance_cost = nullptr,
+  BidirectionalSearchStats* stats = nullptr)
+{
+  using Distance = typename Cost::value_type;
+  using Workspace = BidirectionalWorkspace<Distance>;
+
+  const Layout layout {occupancy_grid.getGridSpec()};
+
+  if (!(layout.spec == occupancy_grid.getGridSpec()) || Layout::kind != occupancy_grid.getLayout())
+    return SearchStatus::INVALID_GRID;
+
+  if (!layout.spec.contains(start) || !layout.spec.contains(goal)) {
+    workspace.getPath().clear();
+    return SearchStatus::OUT_OF_BOUNDS;
+  }
+
+  workspace.reset(layout.getStorageSize());
+
+  const auto start_index {layout.getIndex(start)};
+  const auto goal_index {layout.getIndex(goal)};
+
+  if (start_index == goal_index) {
+    workspace.setCost(Cost::fromFloat(0.F));
+    return SearchStatus::FOUND;
+  }
+
+  // planPath never enters a blocked goal, the backward search would leave it
+  if (occupancy_grid.isBlocked(goal_index))
+    return SearchStatus::NO_PATH;
+
+  if constexpr (staysInComponent<Neighborhood>()) {
+    if (!occupancy_grid.isConnected(start_index, goal_index))
+      return SearchStatus::NO_PATH;
+  }
+
+  struct alignas(CACHE_LINE_SIZE) Direction {
+    unsigned int id;
+    unsigned long expansions {0};
+
+    // Best candidate this direction found, as the move from_index -> to_index of the forward path
+    Distance best_cost {Cost::infinity};
+    unsigned long from_index {0};
+    unsigned long to_index {0};
+
+    // Last key stored below and the settles since
+    Distance published_key {Cost::fromFloat(0.F)};
+    unsigned int unpublished {0};
+
+    // Key of the next cell to settle as of a recent settle, infinity once the open list is empty
+    alignas(CACHE_LINE_SIZE) std::atomic<Distance> key {Cost::fromFloat(0.F)};
+  };
+
+  std::array<Direction, 2> directions {};
+  directions[Workspace::forward].id = Workspace::forward;
+  directions[Workspace::backward].id = Workspace::backward;
+
+  std::atomic<Distance> best_cost {Cost::infinity};
+  std::atomic<bool> done {false};
+
+  // One thread picks the direction by key, a late one would make it lopsided
+  const unsigned int key_interval {use_second_thread ? BIDIRECTIONAL_KEY_INTERVAL : 1U};
+
+  for (const auto& [direction, root_index]: {std::pair {Workspace::forward, start_index},
+    std::pair {Workspace::backward, goal_index}}) {
+    auto& direction_workspace {workspace.getWorkspace(direction)};
+    direction_workspace.setNode(root_index, Cost::fromFloat(0.F), NODE_NO_PARENT);
+    direction_workspace.getOpenList().push({Cost::fromFloat(0.F), static_cast<std::uint32_t>(root_index)});
+  }
+
+  // Settles one cell of direction, false once the search is over
+  auto settleNext {[&](Direction& direction) {
+    auto& direction_workspace {workspace.getWorkspace(direction.id)};
+    auto& open_list {direction_workspace.getOpenList()};
+    const auto& other {directions[1 - direction.id]};
+
+    // Stale entries of nodes that were improved after being pushed
+    while (!open_list.empty() && direction_workspace.isClosed(open_list.top().index))
+      open_list.pop();
+
+    const auto key {open_list.empty() ? Cost::infinity : open_list.top().key};
+
+    if ((++direction.unpublished >= key_interval || key == Cost::infinity) && key != direction.published_key) {
+      direction.key.store(key, std::memory_order_release);
+      direction.published_key = key;
+      direction.unpublished = 0;
+    }
+
+    if (done.load(std::memory_order_acquire))
+      return false;
+
+    // The other key first: the candidates the other direction found below it are in best_cost by then
+    const auto other_key {other.key.load(std::memory_order_acquire)};
+
+    if (!(Cost::add(key, other_key) < best_cost.load(std::memory_order_acquire))) {
+      done.store(true, std::memory_order_release);
+      return false;
+    }
+
+    const unsigned long index {open_list.top().index};
+    open_list.pop();
+
+    direction_workspace.close(index);
+    workspace.settle(direction.id, index, key);
+    direction.expansions++;
+
+    // Orders the settle before the reads of the other direction's cells below
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    forEachChild<Neighborhood>(index, layout.getCellX(index), layout.getCellY(index), occupancy_grid, layout,
+      [&](unsigned long child_index, auto move) {
+        const auto child_distance {getChildDistance<Neighborhood, Cost>(key, move,
+          direction.id == Workspace::forward ? child_index : index, clearance_cost)};
+
+        if (!direction_workspace.isClosed(child_index) && child_distance < direction_workspace.getDistance(child_index)) {
+          direction_workspace.setNode(child_index, child_distance, decltype(move)::value);
+          open_list.push({child_distance, static_cast<std::uint32_t>(child_index)});
+        }
+
+        const auto other_distance {workspace.getSettled(other.id, child_index)};
+
+        if (other_distance == BasicPlannerWorkspace<Distance>::unreached)
+          return;
+
+        if (const auto cost {Cost::add(child_distance, other_distance)}; cost < direction.best_cost) {
+          direction.best_cost = cost;
+          direction.from_index = direction.id == Workspace::forward ? index : child_index;
+          direction.to_index = direction.id == Workspace::forward ? child_index : index;
+          detail::lowerBound(best_cost, cost);
+        }
+      });
+
+    return true;
+  }};
+
+  if (use_second_thread) {
+    std::thread backward_thread {[&]() {
+      while (settleNext(directions[Workspace::backward])) {}
+    }};
+
+    while (settleNext(directions[Workspace::forward])) {}
+
+    backward_thread.join();
+  }
+  else {
+    while (settleNext(directions[directions[Workspace::backward].key.load(std::memory_order_relaxed)
+      < directions[Workspace::forward].key.load(std::memory_order_relaxed)])) {}
+  }
+
+  if (stats != nullptr) {
+    stats->forward_expansions = directions[Workspace::forward].expansions;
+    stats->backward_expansions = directions[Workspace::backward].expansions;
+  }
+
+  const auto& meeting {directions[Workspace::forward].best_cost < directions[Workspace::backward].best_cost
+    ? directions[Workspace::forward] : directions[Workspace::backward]};
+
+  if (meeting.best_cost == Cost::infinity)
+    return SearchStatus::NO_PATH;
+
+  workspace.setCost(meeting.best_cost);
+
+  // Forward half from the start, then the backward half's parents lead to the goal
+  backtrackPath<Neighborhood>(start_index, meeting.from_index, layout, workspace.getWorkspace(Workspace::forward));
+
+  auto& path {workspace.getPath()};
+  const auto& backward_workspace {workspace.getWorkspace(Workspace::backward)};
+  auto index {meeting.to_index};
+
+  path.push_back(layout.getPosition(index));
+
+  while (index != goal_index) {
+    auto move {backward_workspace.getParent(index) & NODE_PARENT_MASK};
+    index = layout.getNeighbor(index, layout.getCellX(index), layout.getCellY(index),
+      -Neighborhood::dx[move], -Neighborhood::dy[move]);
+    path.push_back(layout.getPosition(index));
+  }
+
+  return SearchStatus::FOUND;
+}
+
+}
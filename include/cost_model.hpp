@@ -0,0 +1,67 @@
+/**
+ * @file cost_model.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Float and fixed-point path cost representations
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// Fixed-point units per unit of cost, 1000 keeps 1.4 and 2.2 exact. Path
+// costs above (2^32 - 1) / scale, about 4.3e6 at 1000, saturate and the
+// cells behind them count as unreachable.
+#define COST_FIXED_POINT_SCALE 1000
+
+namespace project2 {
+
+/**
+ * @brief A cost model decides how distances are stored and added up. Move
+ * costs and clearance penalties are given as float and converted once per
+ * use with fromFloat, results are reported back with toFloat.
+ *
+ */
+struct FloatCost {
+  using value_type = float;
+
+  static constexpr value_type infinity {std::numeric_limits<float>::infinity()};
+
+  static constexpr value_type fromFloat(float cost) {return cost;}
+  static constexpr float toFloat(value_type cost) {return cost;}
+
+  static constexpr value_type add(value_type lhs, value_type rhs) {return lhs + rhs;}
+};
+
+/**
+ * @brief Costs as unsigned integers in 1/Scale units. Sums are exact, so ties
+ * compare equal on every compiler and the same query always settles the
+ * cells in the same order. Costs round to the nearest unit. Sums and
+ * conversions saturate at infinity instead of wrapping, so a path longer
+ * than (2^32 - 1) / Scale is never found rather than found out of order.
+ *
+ */
+template <std::uint32_t Scale = COST_FIXED_POINT_SCALE>
+struct FixedPointCost {
+  using value_type = std::uint32_t;
+
+  static constexpr std::uint32_t scale {Scale};
+  static constexpr value_type infinity {std::numeric_limits<std::uint32_t>::max()};
+
+  static constexpr value_type fromFloat(float cost)
+  {
+    return cost * Scale + 0.5F < static_cast<float>(infinity) ? static_cast<value_type>(cost * Scale + 0.5F) : infinity;
+  }
+
+  static constexpr float toFloat(value_type cost) {return static_cast<float>(cost) / Scale;}
+
+  static constexpr value_type add(value_type lhs, value_type rhs)
+  {
+    return rhs < infinity - lhs ? lhs + rhs : infinity;
+  }
+};
+}
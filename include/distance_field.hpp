@@ -0,0 +1,61 @@
+/**
+ * @file distance_field.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Declaration of the obstacle distance field for clearance-aware costs
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <vector>
+
+#include "node_dijkstra.hpp"
+#include "grid_layout.hpp"
+
+#define CLEARANCE_PENALTY_WEIGHT 2.0
+#define CLEARANCE_DECAY_MM 20.0
+
+namespace project2 {
+
+class OccupancyGrid;
+
+enum class CostMode {
+  PLAIN = 0,
+  CLEARANCE = 1
+};
+
+/**
+ * @brief Euclidean distance from every map cell to the nearest obstacle cell
+ * (clearance and map boundary included), with the clearance penalty of each
+ * cell baked in so the search only pays a single lookup per child node.
+ * Stored in the same layout as the occupancy grid.
+ *
+ */
+class DistanceField
+{
+  public:
+    DistanceField(
+      const OccupancyGrid& occupancy_grid,
+      float penalty_weight = CLEARANCE_PENALTY_WEIGHT,
+      float decay_distance = CLEARANCE_DECAY_MM);
+
+    float getDistance(const Position& position) const {return distance_[getIndex(position)];}
+    float getPenalty(const Position& position) const {return penalty_[getIndex(position)];}
+    float getPenalty(unsigned long index) const {return penalty_[index];}
+
+  private:
+    unsigned long getIndex(const Position& position) const {return layout_.getIndex(position);}
+
+    void computeDistanceTransform(std::vector<double>& squared_distance) const;
+
+    GridSpec grid_spec_;
+    DynamicLayout layout_;
+    unsigned int width_;
+    unsigned int height_;
+    std::vector<float> distance_;
+    std::vector<float> penalty_;
+};
+}
@@ -0,0 +1,167 @@
+/**
+ * @file flat_hash_map.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Open-addressing Robin Hood hash map for sparse search state
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <algorithm>
+
+namespace project2 {
+
+/**
+ * @brief Linear probing with Robin Hood displacement: an entry that is
+ * further from its home slot takes the place of a closer one, which keeps
+ * probe sequences short and lets a lookup stop at the first entry closer to
+ * home than the key would be. Entries live in one flat slot array next to a
+ * byte of probe length per slot (0 marks an empty slot), so no lookup chases
+ * pointers the way std::unordered_map does.
+ *
+ * Key and Value have to be default constructible and cheap to move. The hash
+ * has to mix all of its bits, the home slot is taken from the low bits.
+ * Pointers to values stay valid until the next insertion.
+ *
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap
+{
+  public:
+    FlatHashMap() : size_ {0}, mask_ {0} {}
+
+    unsigned long size() const {return size_;}
+    bool empty() const {return size_ == 0;}
+    unsigned long capacity() const {return slots_.size();}
+
+    Value* find(const Key& key)
+    {
+      if (size_ == 0)
+        return nullptr;
+
+      unsigned long slot {hash_(key) & mask_};
+
+      for (std::uint8_t distance {1}; ; distance++) {
+        if (probe_lengths_[slot] < distance)
+          return nullptr;
+
+        if (probe_lengths_[slot] == distance && slots_[slot].first == key)
+          return &slots_[slot].second;
+
+        slot = (slot + 1) & mask_;
+      }
+    }
+
+    const Value* find(const Key& key) const {return const_cast<FlatHashMap*>(this)->find(key);}
+
+    bool contains(const Key& key) const {return find(key) != nullptr;}
+
+    /**
+     * @brief Adds key with value if it is not in the map yet.
+     *
+     * @return The value stored for key and whether it was inserted
+     */
+    std::pair<Value*, bool> insert(const Key& key, const Value& value)
+    {
+      if (auto found {find(key)})
+        return {found, false};
+
+      if ((size_ + 1) * 8 > capacity() * 7)
+        grow();
+
+      return {place(key, value), true};
+    }
+
+    Value& operator[](const Key& key) {return *insert(key, Value {}).first;}
+
+    // Empties the map and keeps its slots for the next query
+    void clear()
+    {
+      std::fill(probe_lengths_.begin(), probe_lengths_.end(), 0);
+      size_ = 0;
+    }
+
+    void reserve(unsigned long count)
+    {
+      unsigned long new_capacity {capacity() == 0 ? 16UL : capacity()};
+
+      while (count * 8 > new_capacity * 7)
+        new_capacity *= 2;
+
+      if (new_capacity > capacity())
+        rehash(new_capacity);
+    }
+
+  private:
+    void grow() {rehash(capacity() == 0 ? 16UL : capacity() * 2);}
+
+    void rehash(unsigned long new_capacity)
+    {
+      std::vector<std::pair<Key, Value>> old_slots (new_capacity);
+      std::vector<std::uint8_t> old_probe_lengths (new_capacity, 0);
+
+      old_slots.swap(slots_);
+      old_probe_lengths.swap(probe_lengths_);
+      mask_ = new_capacity - 1;
+      size_ = 0;
+
+      for (unsigned long slot {0}; slot < old_slots.size(); slot++) {
+        if (old_probe_lengths[slot] != 0)
+          place(old_slots[slot].first, old_slots[slot].second);
+      }
+    }
+
+    // Inserts a key known to be absent, returns where its value ended up
+    Value* place(Key key, Value value)
+    {
+      const Key inserted_key {key};
+      Value* placed {nullptr};
+      unsigned long slot {hash_(key) & mask_};
+      std::uint8_t distance {1};
+
+      while (true) {
+        if (probe_lengths_[slot] == 0) {
+          slots_[slot] = {std::move(key), std::move(value)};
+          probe_lengths_[slot] = distance;
+          size_++;
+
+          return placed != nullptr ? placed : &slots_[slot].second;
+        }
+
+        // Richer entry gives its slot up and carries on probing instead
+        if (probe_lengths_[slot] < distance) {
+          std::swap(key, slots_[slot].first);
+          std::swap(value, slots_[slot].second);
+          std::swap(distance, probe_lengths_[slot]);
+
+          if (placed == nullptr)
+            placed = &slots_[slot].second;
+        }
+
+        slot = (slot + 1) & mask_;
+        distance++;
+
+        // Probe length no longer fits a byte, only with a degenerate hash
+        if (distance == 0xFF) {
+          grow();
+          place(std::move(key), std::move(value));
+
+          return find(inserted_key);
+        }
+      }
+    }
+
+    std::vector<std::pair<Key, Value>> slots_;
+    std::vector<std::uint8_t> probe_lengths_;
+    unsigned long size_;
+    unsigned long mask_;
+    Hash hash_;
+};
+}
@@ -0,0 +1,221 @@
+/**
+ * @file flow_field.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Direction field toward one goal for many agents
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include "grid_search.hpp"
+
+namespace project2 {
+
+namespace detail {
+
+// Move table filled up to 8 entries with zeros, as unsigned offsets that
+// wrap around to the negative steps
+template <typename Neighborhood>
+constexpr std::array<unsigned int, 8> padMoves(const std::array<int, Neighborhood::size>& table)
+{
+  std::array<unsigned int, 8> padded {};
+  for (std::size_t move {0}; move < Neighborhood::size; move++)
+    padded[move] = static_cast<unsigned int>(table[move]);
+
+  return padded;
+}
+
+// Index of the move that undoes each move
+template <typename Neighborhood>
+constexpr std::array<unsigned int, Neighborhood::size> getOppositeMoves()
+{
+  std::array<unsigned int, Neighborhood::size> opposite {};
+
+  for (std::size_t move {0}; move < Neighborhood::size; move++) {
+    for (std::size_t other {0}; other < Neighborhood::size; other++) {
+      if (Neighborhood::dx[other] == -Neighborhood::dx[move] && Neighborhood::dy[other] == -Neighborhood::dy[move])
+        opposite[move] = static_cast<unsigned int>(other);
+    }
+  }
+
+  return opposite;
+}
+
+}
+
+/**
+ * @brief Best move out of every cell toward one goal, from a single Dijkstra
+ * search backward from the goal over its whole component. One build answers
+ * what a search per agent would.
+ *
+ * The backward search charges the clearance penalty of the cell it expands,
+ * which is the cell the forward move enters, so following the field costs
+ * what planPath's path from the same cell costs. Moves are packed in 3 bits
+ * per cell, ten cells to a 32-bit word, so neighborhoods up to 8 moves. A
+ * second bit array marks the cells that have a move, which are the ones the
+ * goal is reachable from, the goal itself excluded.
+ *
+ * Agents are cell coordinates kept as separate x and y arrays. stepAgents()
+ * runs one branch-free pass over them: two table lookups per agent and no
+ * search.
+ *
+ */
+template <typename Neighborhood, typename Spec = GridSpec, typename Layout = RowMajorLayout<Spec>,
+  typename Cost = FloatCost>
+class FlowField
+{
+  static_assert(Neighborhood::size <= 8, "moves are packed in 3 bits");
+
+  public:
+    using Distance = typename Cost::value_type;
+
+    explicit FlowField(const OccupancyGrid& occupancy_grid)
+    : occupancy_grid_ {occupancy_grid},
+      layout_ {occupancy_grid.getGridSpec()},
+      workspace_ {},
+      goal_index_ {0}
+    {}
+
+    // Fills the field toward goal, NO_PATH if the goal is blocked. A goal off
+    // the grid returns OUT_OF_BOUNDS and leaves the field as it was.
+    SearchStatus build(const Position& goal, const DistanceField* clearance_cost = nullptr)
+    {
+      if (!(layout_.spec == occupancy_grid_.getGridSpec()) || Layout::kind != occupancy_grid_.getLayout())
+        return SearchStatus::INVALID_GRID;
+
+      if (!layout_.spec.contains(goal))
+        return SearchStatus::OUT_OF_BOUNDS;
+
+      const unsigned long cell_count {layout_.getStorageSize()};
+
+      moves_.assign((cell_count + cells_per_word - 1) / cells_per_word, 0);
+      has_move_.assign((cell_count + 31) / 32, 0);
+
+      workspace_.reset(cell_count);
+      goal_index_ = layout_.getIndex(goal);
+
+      if (occupancy_grid_.isBlocked(goal_index_))
+        return SearchStatus::NO_PATH;
+
+      auto& open_list {workspace_.getOpenList()};
+
+      workspace_.setNode(goal_index_, Cost::fromFloat(0.F), NODE_NO_PARENT);
+      open_list.push({Cost::fromFloat(0.F), static_cast<std::uint32_t>(goal_index_)});
+
+      while (!open_list.empty()) {
+        const auto current_node {open_list.top()};
+        open_list.pop();
+
+        if (workspace_.isClosed(current_node.index))
+          continue;
+
+        workspace_.close(current_node.index);
+
+        const unsigned long index {current_node.index};
+
+        // A backward move into child is the forward move child -> index
+        if (index != goal_index_)
+          setMove(index, opposite_move[workspace_.getParent(index) & NODE_PARENT_MASK]);
+
+        forEachChild<Neighborhood>(index, layout_.getCellX(index), layout_.getCellY(index), occupancy_grid_,
+          layout_, [&](unsigned long child_index, auto move) {
+            if (workspace_.isClosed(child_index))
+              return;
+
+            const auto child_distance {getChildDistance<Neighborhood, Cost>(current_node.key, move, index,
+              clearance_cost)};
+
+            if (child_distance < workspace_.getDistance(child_index)) {
+              workspace_.setNode(child_index, child_distance, decltype(move)::value);
+              open_list.push({child_distance, static_cast<std::uint32_t>(child_index)});
+            }
+          });
+      }
+
+      return SearchStatus::FOUND;
+    }
+
+    // Whether the cell has a move, every cell the goal is reachable from but the goal
+    bool hasMove(unsigned long index) const
+    {
+      const auto cell {static_cast<std::uint32_t>(index)};
+
+      return (has_move_[cell >> 5] >> (cell & 31)) & 1U;
+    }
+
+    // Neighborhood move out of a cell that has one
+    unsigned int getMove(unsigned long index) const
+    {
+      const auto cell {static_cast<std::uint32_t>(index)};
+
+      return (moves_[cell / cells_per_word] >> (cell % cells_per_word * 3)) & 7U;
+    }
+
+    // Cost of following the field from the cell to the goal
+    Distance getDistance(unsigned long index) const {return workspace_.getDistance(index);}
+
+    unsigned long getGoalIndex() const {return goal_index_;}
+
+    /**
+     * @brief Moves every agent one cell along the field. Agents on the goal
+     * or on cells the goal can't be reached from stay where they are.
+     *
+     */
+    void stepAgents(std::vector<unsigned int>& agent_x, std::vector<unsigned int>& agent_y) const
+    {
+      stepAgents(agent_x.data(), agent_y.data(), agent_x.size(), moves_.data(), has_move_.data(), layout_);
+    }
+
+  private:
+    // 3-bit moves of 10 cells per word, the top 2 bits unused. Words of 32 bits
+    // keep every lookup of the agent loop a 32-bit gather.
+    static constexpr std::uint32_t cells_per_word {10};
+
+    // Every 3-bit value indexes the tables, so the agent loop needs no check
+    static constexpr std::array<unsigned int, 8> move_dx {detail::padMoves<Neighborhood>(Neighborhood::dx)};
+    static constexpr std::array<unsigned int, 8> move_dy {detail::padMoves<Neighborhood>(Neighborhood::dy)};
+    static constexpr std::array<unsigned int, Neighborhood::size> opposite_move {
+      detail::getOppositeMoves<Neighborhood>()};
+
+    // Restrict pointers let GCC gather the lookups of several agents at once, at
+    // -O3 with AVX2 (PROJECT2_ENABLE_AVX2). Other builds run the loop scalar.
+    static void stepAgents(
+      unsigned int* __restrict x,
+      unsigned int* __restrict y,
+      std::size_t agent_count,
+      const std::uint32_t* __restrict moves,
+      const std::uint32_t* __restrict has_move,
+      const Layout layout)
+    {
+      for (std::size_t i {0}; i < agent_count; i++) {
+        const auto cell {static_cast<std::uint32_t>(layout.getIndex(x[i], y[i]))};
+        const unsigned int move {(moves[cell / cells_per_word] >> (cell % cells_per_word * 3)) & 7U};
+        const unsigned int moving {(has_move[cell >> 5] >> (cell & 31)) & 1U};
+
+        x[i] += moving * move_dx[move];
+        y[i] += moving * move_dy[move];
+      }
+    }
+
+    void setMove(unsigned long index, unsigned int move)
+    {
+      moves_[index / cells_per_word] |= move << (index % cells_per_word * 3);
+      has_move_[index >> 5] |= 1U << (index & 31);
+    }
+
+    const OccupancyGrid& occupancy_grid_;
+    const Layout layout_;
+    BasicPlannerWorkspace<Distance> workspace_;
+    std::vector<std::uint32_t> moves_ {};
+    std::vector<std::uint32_t> has_move_ {};
+    unsigned long goal_index_;
+};
+
+}
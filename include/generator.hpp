@@ -0,0 +1,93 @@
+/**
+ * @file generator.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Minimal C++20 coroutine generator
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace project2 {
+
+/**
+ * @brief Coroutine that produces values one co_yield at a time. It starts
+ * suspended and only runs when next() resumes it, on whatever thread calls
+ * next(). The value refers to the yielded object inside the coroutine and is
+ * valid until the next resume.
+ *
+ */
+template <typename T>
+class Generator
+{
+  public:
+    struct promise_type {
+      const T* value {nullptr};
+      std::exception_ptr exception {};
+
+      Generator get_return_object() {return Generator {std::coroutine_handle<promise_type>::from_promise(*this)};}
+
+      std::suspend_always initial_suspend() noexcept {return {};}
+      std::suspend_always final_suspend() noexcept {return {};}
+
+      std::suspend_always yield_value(const T& yielded) noexcept
+      {
+        value = std::addressof(yielded);
+        return {};
+      }
+
+      void return_void() noexcept {}
+      void unhandled_exception() {exception = std::current_exception();}
+    };
+
+    Generator() = default;
+    Generator(Generator&& other) noexcept : handle_ {std::exchange(other.handle_, {})} {}
+
+    Generator& operator=(Generator&& other) noexcept
+    {
+      if (this != &other) {
+        if (handle_)
+          handle_.destroy();
+
+        handle_ = std::exchange(other.handle_, {});
+      }
+
+      return *this;
+    }
+
+    ~Generator()
+    {
+      if (handle_)
+        handle_.destroy();
+    }
+
+    // Runs the coroutine to its next co_yield, false once it has returned
+    bool next()
+    {
+      if (done())
+        return false;
+
+      handle_.resume();
+
+      if (handle_.promise().exception)
+        std::rethrow_exception(std::exchange(handle_.promise().exception, {}));
+
+      return !handle_.done();
+    }
+
+    const T& value() const {return *handle_.promise().value;}
+    bool done() const {return !handle_ || handle_.done();}
+
+  private:
+    explicit Generator(std::coroutine_handle<promise_type> handle) : handle_ {handle} {}
+
+    std::coroutine_handle<promise_type> handle_ {};
+};
+}
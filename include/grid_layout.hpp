@@ -0,0 +1,296 @@
+/**
+ * @file grid_layout.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Memory layouts of the per-cell grid arrays
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "node_dijkstra.hpp"
+
+// Tiles of 2^GRID_TILE_BITS cells per side for GridLayout::TILED
+#ifndef GRID_TILE_BITS
+#define GRID_TILE_BITS 3
+#endif
+
+// Blocked border of GridLayout::PADDED, wide enough for the knight moves
+#define GRID_PADDING 2
+
+namespace project2 {
+
+enum class GridLayout {
+  ROW_MAJOR = 0,
+  TILED = 1,
+  PADDED = 2
+};
+
+/**
+ * @brief A layout maps cell coordinates to the storage index shared by the
+ * occupancy grid, the distance field and the search workspace. The search
+ * only talks to the layout, so changing the order of the arrays doesn't
+ * touch the search code. A padded layout promises that every move of the
+ * neighborhoods lands inside the storage, on a blocked border cell at worst.
+ *
+ */
+template <typename Spec = GridSpec>
+struct RowMajorLayout {
+  static constexpr GridLayout kind {GridLayout::ROW_MAJOR};
+  static constexpr bool padded {false};
+
+  explicit RowMajorLayout(const GridSpec& grid_spec) : spec {grid_spec} {}
+
+  unsigned long getStorageSize() const {return spec.getCellCount();}
+
+  unsigned long getIndex(long cell_x, long cell_y) const
+  {
+    return cell_x + static_cast<unsigned long>(spec.getColumns()) * cell_y;
+  }
+
+  unsigned long getIndex(const Position& position) const {return spec.getIndex(position);}
+
+  long getCellX(unsigned long index) const {return static_cast<long>(index % spec.getColumns());}
+  long getCellY(unsigned long index) const {return static_cast<long>(index / spec.getColumns());}
+
+  Position getPosition(unsigned long index) const {return spec.getPosition(index);}
+
+  // Neighbors are a constant offset away in row-major order
+  unsigned long getNeighbor(unsigned long index, long, long, int dx, int dy) const
+  {
+    return index + dx + static_cast<long>(spec.getColumns()) * dy;
+  }
+
+  Spec spec;
+};
+
+/**
+ * @brief Square tiles of 2^GRID_TILE_BITS cells per side in row-major order,
+ * cells in Z-order (Morton) inside every tile. All 8 neighbors of a cell mostly
+ * share its tile, so an expansion touches one or two cache lines per array
+ * instead of one per grid row. Partial tiles at the map edge are padded.
+ *
+ */
+template <typename Spec = GridSpec>
+struct TiledLayout {
+  static constexpr GridLayout kind {GridLayout::TILED};
+  static constexpr bool padded {false};
+  static constexpr unsigned int tile_bits {GRID_TILE_BITS};
+  static constexpr unsigned int tile_size {1U << tile_bits};
+  static constexpr unsigned long tile_area {1UL << (2 * tile_bits)};
+
+  explicit TiledLayout(const GridSpec& grid_spec)
+  : spec {grid_spec},
+    tile_columns {(spec.getColumns() + tile_size - 1) >> tile_bits},
+    tile_rows {(spec.getRows() + tile_size - 1) >> tile_bits}
+  {}
+
+  unsigned long getStorageSize() const {return static_cast<unsigned long>(tile_columns) * tile_rows * tile_area;}
+
+  unsigned long getIndex(long cell_x, long cell_y) const
+  {
+    const unsigned long tile {(static_cast<unsigned long>(cell_x) >> tile_bits)
+      + static_cast<unsigned long>(tile_columns) * (static_cast<unsigned long>(cell_y) >> tile_bits)};
+
+    return (tile << (2 * tile_bits)) | getLocalIndex(cell_x & (tile_size - 1), cell_y & (tile_size - 1));
+  }
+
+  unsigned long getIndex(const Position& position) const
+  {
+    return getIndex(position.x / spec.cell_size, position.y / spec.cell_size);
+  }
+
+  long getCellX(unsigned long index) const
+  {
+    return static_cast<long>(((index >> (2 * tile_bits)) % tile_columns) << tile_bits | compactBits(index));
+  }
+
+  long getCellY(unsigned long index) const
+  {
+    return static_cast<long>(((index >> (2 * tile_bits)) / tile_columns) << tile_bits | compactBits(index >> 1));
+  }
+
+  Position getPosition(unsigned long index) const
+  {
+    return Position(static_cast<unsigned int>(getCellX(index)) * spec.cell_size,
+                    static_cast<unsigned int>(getCellY(index)) * spec.cell_size);
+  }
+
+  // Neighbors inside the same tile only swap the Z-order bits of the tile
+  unsigned long getNeighbor(unsigned long index, long cell_x, long cell_y, int dx, int dy) const
+  {
+    const unsigned long local_x {static_cast<unsigned long>((cell_x & (tile_size - 1)) + dx)};
+    const unsigned long local_y {static_cast<unsigned long>((cell_y & (tile_size - 1)) + dy)};
+
+    if (local_x < tile_size && local_y < tile_size)
+      return (index & ~(tile_area - 1)) | getLocalIndex(local_x, local_y);
+
+    return getIndex(cell_x + dx, cell_y + dy);
+  }
+
+  static unsigned long getLocalIndex(unsigned long local_x, unsigned long local_y)
+  {
+    return spread_table[local_x] | (spread_table[local_y] << 1);
+  }
+
+  // Bit i of value to bit 2i
+  static constexpr unsigned long spreadBits(unsigned long value)
+  {
+    unsigned long spread {0};
+
+    for (unsigned int i {0}; i < tile_bits; i++)
+      spread |= ((value >> i) & 1UL) << (2 * i);
+
+    return spread;
+  }
+
+  // Bit 2i of value to bit i
+  static constexpr unsigned long compactBits(unsigned long value)
+  {
+    unsigned long compact {0};
+
+    for (unsigned int i {0}; i < tile_bits; i++)
+      compact |= ((value >> (2 * i)) & 1UL) << i;
+
+    return compact;
+  }
+
+  static constexpr std::array<unsigned long, tile_size> makeSpreadTable()
+  {
+    std::array<unsigned long, tile_size> table {};
+
+    for (unsigned int i {0}; i < tile_size; i++)
+      table[i] = spreadBits(i);
+
+    return table;
+  }
+
+  static constexpr std::array<unsigned long, tile_size> spread_table {makeSpreadTable()};
+
+  Spec spec;
+  unsigned int tile_columns;
+  unsigned int tile_rows;
+};
+
+/**
+ * @brief Row-major with a GRID_PADDING wide border of blocked cells around
+ * the map. Moves off the map land on the border instead of outside of the
+ * arrays, so the search needs no bounds checks and no coordinates at all.
+ *
+ */
+template <typename Spec = GridSpec>
+struct PaddedLayout {
+  static constexpr GridLayout kind {GridLayout::PADDED};
+  static constexpr bool padded {true};
+  static constexpr long padding {GRID_PADDING};
+
+  explicit PaddedLayout(const GridSpec& grid_spec) : spec {grid_spec} {}
+
+  long getStride() const {return static_cast<long>(spec.getColumns()) + 2 * padding;}
+
+  unsigned long getStorageSize() const
+  {
+    return static_cast<unsigned long>(getStride()) * (spec.getRows() + 2 * padding);
+  }
+
+  unsigned long getIndex(long cell_x, long cell_y) const
+  {
+    return (cell_x + padding) + static_cast<unsigned long>(getStride()) * (cell_y + padding);
+  }
+
+  unsigned long getIndex(const Position& position) const
+  {
+    return getIndex(position.x / spec.cell_size, position.y / spec.cell_size);
+  }
+
+  long getCellX(unsigned long index) const {return static_cast<long>(index % getStride()) - padding;}
+  long getCellY(unsigned long index) const {return static_cast<long>(index / getStride()) - padding;}
+
+  Position getPosition(unsigned long index) const
+  {
+    return Position(static_cast<unsigned int>(getCellX(index)) * spec.cell_size,
+                    static_cast<unsigned int>(getCellY(index)) * spec.cell_size);
+  }
+
+  unsigned long getNeighbor(unsigned long index, long, long, int dx, int dy) const
+  {
+    return index + dx + getStride() * dy;
+  }
+
+  Spec spec;
+};
+
+/**
+ * @brief Layout picked at runtime, for the code that fills and queries the
+ * cell arrays outside of the search loop.
+ *
+ */
+struct DynamicLayout {
+  DynamicLayout(const GridSpec& grid_spec, GridLayout layout)
+  : kind {layout}, row_major {grid_spec}, tiled {grid_spec}, padded {grid_spec}
+  {}
+
+  unsigned long getStorageSize() const
+  {
+    switch (kind) {
+      case GridLayout::TILED:
+        return tiled.getStorageSize();
+      case GridLayout::PADDED:
+        return padded.getStorageSize();
+      default:
+        return row_major.getStorageSize();
+    }
+  }
+
+  unsigned long getIndex(long cell_x, long cell_y) const
+  {
+    switch (kind) {
+      case GridLayout::TILED:
+        return tiled.getIndex(cell_x, cell_y);
+      case GridLayout::PADDED:
+        return padded.getIndex(cell_x, cell_y);
+      default:
+        return row_major.getIndex(cell_x, cell_y);
+    }
+  }
+
+  unsigned long getIndex(const Position& position) const
+  {
+    return getIndex(position.x / row_major.spec.cell_size, position.y / row_major.spec.cell_size);
+  }
+
+  long getCellX(unsigned long index) const
+  {
+    switch (kind) {
+      case GridLayout::TILED:
+        return tiled.getCellX(index);
+      case GridLayout::PADDED:
+        return padded.getCellX(index);
+      default:
+        return row_major.getCellX(index);
+    }
+  }
+
+  long getCellY(unsigned long index) const
+  {
+    switch (kind) {
+      case GridLayout::TILED:
+        return tiled.getCellY(index);
+      case GridLayout::PADDED:
+        return padded.getCellY(index);
+      default:
+        return row_major.getCellY(index);
+    }
+  }
+
+  GridLayout kind;
+  RowMajorLayout<GridSpec> row_major;
+  TiledLayout<GridSpec> tiled;
+  PaddedLayout<GridSpec> padded;
+};
+}
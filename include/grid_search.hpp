@@ -0,0 +1,528 @@
+/**
+ * @file grid_search.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Dijkstra search on the occupancy grid, templated on the neighborhood
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "project2.hpp"
+#include "neighborhood.hpp"
+#include "grid_layout.hpp"
+#include "cost_model.hpp"
+#include "planner_workspace.hpp"
+#include "sparse_workspace.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "search_limits.hpp"
+
+namespace project2 {
+
+namespace detail {
+
+// Lowers an atomic distance shared between search threads to value
+template <typename Distance>
+void lowerBound(std::atomic<Distance>& bound, Distance value)
+{
+  auto current {bound.load(std::memory_order_relaxed)};
+
+  while (value < current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+}
+
+/**
+ * @brief Follows the parent directions from the goal back to the start into
+ * the workspace path, which excludes the start cell and includes the goal.
+ *
+ */
+template <typename Neighborhood, typename Layout = RowMajorLayout<GridSpec>, typename Distance = float>
+void backtrackPath(
+  unsigned long start_index,
+  unsigned long goal_index,
+  const Layout& layout,
+  BasicPlannerWorkspace<Distance>& workspace)
+{
+  auto& path {workspace.getPath()};
+  path.clear();
+
+  auto index {goal_index};
+
+  while (index != start_index) {
+    path.push_back(layout.getPosition(index));
+
+    auto move {workspace.getParent(index) & NODE_PARENT_MASK};
+    index = layout.getNeighbor(index, layout.getCellX(index), layout.getCellY(index),
+      -Neighborhood::dx[move], -Neighborhood::dy[move]);
+  }
+
+  std::reverse(path.begin(), path.end());
+}
+
+/**
+ * @brief Calls visit(child_index, move) for every move out of a cell that
+ * lands on a free cell, move being a std::integral_constant. Moves covered by
+ * the grid neighbor masks need no checks at all, the others one bounds
+ * checked lookup, none with a padded layout.
+ *
+ */
+template <typename Neighborhood, typename Layout, typename Visit>
+void forEachChild(
+  unsigned long index,
+  long cell_x,
+  long cell_y,
+  const OccupancyGrid& occupancy_grid,
+  const Layout& layout,
+  Visit&& visit)
+{
+  const long columns {layout.spec.getColumns()};
+  const long rows {layout.spec.getRows()};
+  const unsigned int neighbor_mask {occupancy_grid.getNeighborMask(index)};
+
+  project2::forEachMove<Neighborhood>([&](auto move) {
+    constexpr auto i {decltype(move)::value};
+
+    if constexpr (Neighborhood::mask_bit[i] >= 0) {
+      if ((neighbor_mask & (1U << Neighborhood::mask_bit[i])) == 0)
+        return;
+    }
+    else if constexpr (Layout::padded) {
+      if (occupancy_grid.isBlocked(layout.getNeighbor(index, cell_x, cell_y, Neighborhood::dx[i], Neighborhood::dy[i])))
+        return;
+    }
+    else {
+      const long neighbor_x {cell_x + Neighborhood::dx[i]};
+      const long neighbor_y {cell_y + Neighborhood::dy[i]};
+
+      if (neighbor_x < 0 || neighbor_x >= columns || neighbor_y < 0 || neighbor_y >= rows
+        || occupancy_grid.isBlocked(layout.getNeighbor(index, cell_x, cell_y, Neighborhood::dx[i], Neighborhood::dy[i])))
+        return;
+    }
+
+    visit(layout.getNeighbor(index, cell_x, cell_y, Neighborhood::dx[i], Neighborhood::dy[i]), move);
+  });
+}
+
+// Distance of a child reached with move from a cell at distance key
+template <typename Neighborhood, typename Cost, typename Move>
+typename Cost::value_type getChildDistance(
+  typename Cost::value_type key,
+  Move,
+  unsigned long child_index,
+  const DistanceField* clearance_cost)
+{
+  constexpr typename Cost::value_type move_cost {Cost::fromFloat(Neighborhood::cost[Move::value])};
+  typename Cost::value_type child_distance {Cost::add(key, move_cost)};
+
+  if (clearance_cost != nullptr)
+    child_distance = Cost::add(child_distance, Cost::fromFloat(clearance_cost->getPenalty(child_index)));
+
+  return child_distance;
+}
+
+// Relaxes the moves out of a settled cell into the workspace and its open list
+template <typename Neighborhood, typename Layout, typename Cost>
+void expandCell(
+  const BasicPackedNode<typename Cost::value_type>& current_node,
+  long cell_x,
+  long cell_y,
+  const OccupancyGrid& occupancy_grid,
+  const Layout& layout,
+  BasicPlannerWorkspace<typename Cost::value_type>& workspace,
+  const DistanceField* clearance_cost)
+{
+  auto& open_list {workspace.getOpenList()};
+
+  forEachChild<Neighborhood>(current_node.index, cell_x, cell_y, occupancy_grid, layout,
+    [&](unsigned long child_index, auto move) {
+      if (workspace.isClosed(child_index))
+        return;
+
+      const auto child_distance {getChildDistance<Neighborhood, Cost>(current_node.key, move, child_index,
+        clearance_cost)};
+
+      if (child_distance < workspace.getDistance(child_index)) {
+        workspace.setNode(child_index, child_distance, decltype(move)::value);
+        open_list.push({child_distance, static_cast<std::uint32_t>(child_index)});
+      }
+    });
+}
+
+/**
+ * @brief State of one grid search, shared by planPath and the stepped
+ * search so both run the exact same loop: start() checks the grid and both
+ * ends and seeds the open list, settleNext() settles one cell, finish()
+ * backtracks to the goal or to the best partial result.
+ *
+ */
+template <typename Neighborhood, typename Layout, typename Cost>
+class GridSearch
+{
+  public:
+    GridSearch(
+      const Position& start,
+      const Position& goal,
+      const OccupancyGrid& occupancy_grid,
+      BasicPlannerWorkspace<typename Cost::value_type>& workspace,
+      const DistanceField* clearance_cost,
+      const SearchLimits& limits)
+    : layout_ {occupancy_grid.getGridSpec()},
+      occupancy_grid_ {occupancy_grid},
+      workspace_ {workspace},
+      clearance_cost_ {clearance_cost},
+      limits_ {limits},
+      in_bounds_ {layout_.spec.contains(start) && layout_.spec.contains(goal)},
+      start_index_ {layout_.getIndex(start)},
+      goal_index_ {layout_.getIndex(goal)},
+      goal_x_ {layout_.getCellX(goal_index_)},
+      goal_y_ {layout_.getCellY(goal_index_)},
+      best_index_ {start_index_},
+      best_distance_ {std::numeric_limits<long>::max()},
+      expansions_ {0},
+      next_check_ {limits.getNextCheck(0)}
+    {}
+
+    // RUNNING, or why there is nothing to search
+    SearchStatus start()
+    {
+      if (!(layout_.spec == occupancy_grid_.getGridSpec()) || Layout::kind != occupancy_grid_.getLayout())
+        return SearchStatus::INVALID_GRID;
+
+      if (!in_bounds_)
+        return SearchStatus::OUT_OF_BOUNDS;
+
+      workspace_.reset(layout_.getStorageSize());
+      workspace_.setNode(start_index_, Cost::fromFloat(0.F), NODE_NO_PARENT);
+      workspace_.getOpenList().push({Cost::fromFloat(0.F), static_cast<std::uint32_t>(start_index_)});
+
+      return checkQuery();
+    }
+
+    /**
+     * @brief start() for a workspace that holds the tree of an earlier search
+     * from the same start on the same map. FOUND right away if that search
+     * settled the goal already, RUNNING to go on from its open list.
+     *
+     */
+    SearchStatus resume()
+    {
+      if (!(layout_.spec == occupancy_grid_.getGridSpec()) || Layout::kind != occupancy_grid_.getLayout())
+        return SearchStatus::INVALID_GRID;
+
+      if (!in_bounds_)
+        return SearchStatus::OUT_OF_BOUNDS;
+
+      if (workspace_.isClosed(goal_index_))
+        return SearchStatus::FOUND;
+
+      return checkQuery();
+    }
+
+    /**
+     * @brief Settles the next cell and calls on_settled(index) with it.
+     *
+     * @return RUNNING while the search goes on, FOUND once the goal is
+     * settled, NO_PATH once the open list runs dry, or the limit that
+     * stopped it
+     */
+    template <typename OnSettled>
+    SearchStatus settleNext(OnSettled&& on_settled)
+    {
+      if (expansions_ == next_check_) {
+        if (const auto status {limits_.check(expansions_)}; status != SearchStatus::RUNNING)
+          return status;
+
+        next_check_ = limits_.getNextCheck(expansions_);
+      }
+
+      auto& open_list {workspace_.getOpenList()};
+
+      while (true) {
+        if (open_list.empty())
+          return SearchStatus::NO_PATH;
+
+        const auto current_node {open_list.top()};
+        open_list.pop();
+
+        // Stale entry of a node that was improved after being pushed
+        if (workspace_.isClosed(current_node.index))
+          continue;
+
+        workspace_.close(current_node.index);
+        expansions_++;
+
+        const unsigned long index {current_node.index};
+        on_settled(index);
+
+        const long cell_x {layout_.getCellX(index)};
+        const long cell_y {layout_.getCellY(index)};
+
+        // Settled cell closest to the goal, squared distance in cells
+        if (const long distance {(cell_x - goal_x_) * (cell_x - goal_x_) + (cell_y - goal_y_) * (cell_y - goal_y_)};
+          distance < best_distance_) {
+          best_distance_ = distance;
+          best_index_ = index;
+        }
+
+        // The goal is expanded too, so the tree stays whole for resume()
+        expandCell<Neighborhood, Layout, Cost>(current_node, cell_x, cell_y, occupancy_grid_, layout_,
+          workspace_, clearance_cost_);
+
+        return index == goal_index_ ? SearchStatus::FOUND : SearchStatus::RUNNING;
+      }
+    }
+
+    // Writes the path of a search that ended with status, returns status
+    SearchStatus finish(SearchStatus status)
+    {
+      if (status == SearchStatus::INVALID_GRID || status == SearchStatus::OUT_OF_BOUNDS)
+        workspace_.getPath().clear();
+      else
+        backtrackPath<Neighborhood>(start_index_, status == SearchStatus::FOUND ? goal_index_ : best_index_,
+          layout_, workspace_);
+
+      return status;
+    }
+
+    unsigned long getExpansions() const {return expansions_;}
+    const Layout& getLayout() const {return layout_;}
+
+  private:
+    // RUNNING unless the query is over before its first settle
+    SearchStatus checkQuery() const
+    {
+      // A goal in another component would drain the whole open list first
+      if constexpr (staysInComponent<Neighborhood>()) {
+        if (!occupancy_grid_.isConnected(start_index_, goal_index_))
+          return SearchStatus::NO_PATH;
+      }
+
+      // Cancelled or out of time before the first settle
+      return limits_.check(0);
+    }
+
+    const Layout layout_;
+    const OccupancyGrid& occupancy_grid_;
+    BasicPlannerWorkspace<typename Cost::value_type>& workspace_;
+    const DistanceField* clearance_cost_;
+    const SearchLimits& limits_;
+
+    // Cell indices below are only meaningful when both ends are on the grid
+    const bool in_bounds_;
+    const unsigned long start_index_;
+    const unsigned long goal_index_;
+    const long goal_x_;
+    const long goal_y_;
+
+    unsigned long best_index_;
+    long best_distance_;
+    unsigned long expansions_;
+    unsigned long next_check_;
+};
+
+/**
+ * @brief Dijkstra search with the successor generation of Neighborhood
+ * unrolled at compile time (expandCell).
+ *
+ * Spec is GridSpec for maps sized at runtime, or a FixedGridSpec matching
+ * the occupancy grid to get the index math specialized at compile time.
+ * Layout is the order of the cell arrays and has to be the one the occupancy
+ * grid was built with. With a padded layout no move needs a bounds check.
+ *
+ * Nodes are packed: the open list holds (key, cell index) pairs and each
+ * cell keeps its best distance and a parent byte in the workspace, which is
+ * reset in O(1) and reused across queries. The path ends up in
+ * workspace.getPath(), settled cells are pushed to explored_nodes if given.
+ * The search never waits for the consumer of explored_nodes, cells that
+ * don't fit anymore are dropped.
+ *
+ * Cost is FloatCost or a FixedPointCost, whose workspace keeps integer
+ * distances (FixedPlannerWorkspace for the default scale).
+ *
+ * The search stops early when limits says so. Unless the goal was found,
+ * workspace.getPath() is the best partial result: the path to the settled
+ * cell closest to the goal. A start or goal off the grid returns
+ * OUT_OF_BOUNDS with an empty path.
+ *
+ */
+template <typename Neighborhood, typename Spec = GridSpec, typename Layout = RowMajorLayout<Spec>,
+  typename Cost = FloatCost>
+SearchStatus planPath(
+  const Position& start,
+  const Position& goal,
+  const OccupancyGrid& occupancy_grid,
+  BasicPlannerWorkspace<typename Cost::value_type>& workspace,
+  const DistanceField* clearance_cost = nullptr,
+  SpscRingBuffer<TwoDE::vec2ui>* explored_nodes = nullptr,
+  const SearchLimits& limits = SearchLimits {})
+{
+  GridSearch<Neighborhood, Layout, Cost> search {start, goal, occupancy_grid, workspace, clearance_cost, limits};
+  auto status {search.start()};
+
+  while (status == SearchStatus::RUNNING) {
+    status = search.settleNext([&](unsigned long index) {
+      if (explored_nodes != nullptr) {
+        const auto position {search.getLayout().getPosition(index)};
+        explored_nodes->tryPush(TwoDE::vec2ui(position.x, position.y));
+      }
+    });
+  }
+
+  return search.finish(status);
+}
+
+/**
+ * @brief planPath on an unbounded grid of signed cell coordinates.
+ * is_free(cell) decides which cells can be entered, only the cells the
+ * search reaches are stored. Gives up after max_expansions settled cells, on
+ * an unbounded map that is the only way out when the goal can't be reached.
+ * Coordinates have to stay a few cells inside the range of long.
+ *
+ */
+template <typename Neighborhood, typename IsFree>
+bool planPathSparse(
+  const CellCoord& start,
+  const CellCoord& goal,
+  const IsFree& is_free,
+  SparsePlannerWorkspace& workspace,
+  unsigned long max_expansions = std::numeric_limits<unsigned long>::max())
+{
+  workspace.reset();
+  auto& open_list {workspace.getOpenList()};
+
+  const auto start_node {workspace.getNode(start)};
+  workspace.setNode(start_node, 0.F, NODE_NO_PARENT);
+  open_list.push({0.F, start_node});
+
+  unsigned long expansions {0};
+
+  while (!open_list.empty() && expansions < max_expansions) {
+    const auto current_node {open_list.top()};
+    open_list.pop();
+
+    if (workspace.isClosed(current_node.index))
+      continue;
+
+    workspace.close(current_node.index);
+    expansions++;
+
+    const CellCoord cell {workspace.getCell(current_node.index)};
+
+    if (cell == goal) {
+      auto& path {workspace.getPath()};
+      auto node {current_node.index};
+
+      while (node != start_node) {
+        const auto& node_cell {workspace.getCell(node)};
+        path.push_back(node_cell);
+
+        auto move {workspace.getParent(node) & NODE_PARENT_MASK};
+        node = *workspace.findNode({node_cell.x - Neighborhood::dx[move], node_cell.y - Neighborhood::dy[move]});
+      }
+
+      std::reverse(path.begin(), path.end());
+      return true;
+    }
+
+    project2::forEachMove<Neighborhood>([&](auto move) {
+      constexpr auto i {decltype(move)::value};
+
+      const CellCoord child {cell.x + Neighborhood::dx[i], cell.y + Neighborhood::dy[i]};
+
+      if (!is_free(child))
+        return;
+
+      const auto child_node {workspace.getNode(child)};
+
+      if (workspace.isClosed(child_node))
+        return;
+
+      const float child_distance {current_node.key + Neighborhood::cost[i]};
+
+      if (child_distance < workspace.getDistance(child_node)) {
+        workspace.setNode(child_node, child_distance, i);
+        open_list.push({child_distance, child_node});
+      }
+    });
+  }
+
+  return false;
+}
+
+/**
+ * @brief planPath for the viewer: streams the explored cells to the renderer
+ * and reports the goal node the way searchDijkstra always has, or why the
+ * search stopped. backtracked_path gets the path to the goal, or the best
+ * partial path when the goal wasn't reached. It is written before
+ * search_complete is set (release), the renderer reads it after seeing the
+ * flag (acquire).
+ *
+ */
+template <typename Neighborhood, typename Spec = GridSpec, typename Layout = RowMajorLayout<Spec>,
+  typename Cost = FloatCost>
+SearchStatus searchGrid(
+  Node& start_node,
+  Node& goal_node,
+  const OccupancyGrid& occupancy_grid,
+  SpscRingBuffer<TwoDE::vec2ui>& explored_nodes,
+  std::deque<TwoDE::vec2ui>& backtracked_path,
+  const SearchLimits& limits,
+  std::atomic<bool>& search_complete,
+  const DistanceField* clearance_cost = nullptr)
+{
+  const Layout layout {occupancy_grid.getGridSpec()};
+
+  if (!(layout.spec == occupancy_grid.getGridSpec()) || Layout::kind != occupancy_grid.getLayout()) {
+    std::cout << '\n' << "Grid specification or layout doesn't match the occupancy grid" << '\n';
+    return SearchStatus::INVALID_GRID;
+  }
+
+  project2::BasicPlannerWorkspace<typename Cost::value_type> workspace {layout.getStorageSize()};
+
+  std::cout << '\n' << "Searching..." << '\n';
+  auto t_begin {std::chrono::high_resolution_clock::now()};
+
+  const auto status {planPath<Neighborhood, Spec, Layout, Cost>(start_node.getPosition(),
+    goal_node.getPosition(), occupancy_grid, workspace, clearance_cost,
+    &explored_nodes, limits)};
+
+  auto t_end {std::chrono::high_resolution_clock::now()};
+
+  std::chrono::duration<float, std::ratio<1L, 1L>> exec_time {t_end - t_begin};
+
+  const auto& path {workspace.getPath()};
+
+  if (status == SearchStatus::FOUND) {
+    const auto goal_index {layout.getIndex(goal_node.getPosition())};
+    const auto& from_position {path.size() > 1 ? path[path.size() - 2] : start_node.getPosition()};
+
+    goal_node = project2::Node(goal_node.getPosition(), from_position, Cost::toFloat(workspace.getDistance(goal_index)));
+
+    std::cout << '\n' << "-- Goal node found --" << '\n';
+    std::cout << goal_node << '\n' << '\n';
+  }
+  else {
+    std::cout << '\n' << "Search stopped: " << toString(status) << ", partial path of "
+      << path.size() << " cells" << '\n';
+  }
+
+  std::cout << "Execution time: " << exec_time.count() << " seconds" << '\n';
+
+  backtracked_path.clear();
+  for (const auto& position: path)
+    backtracked_path.push_back(TwoDE::vec2ui(position.x, position.y));
+
+  search_complete.store(true, std::memory_order_release);
+
+  return status;
+}
+
+}
@@ -0,0 +1,83 @@
+/**
+ * @file mpsc_queue.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Lock-free unbounded multi-producer single-consumer queue
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+namespace project2 {
+
+/**
+ * @brief Vyukov's intrusive-style MPSC queue: a push is one exchange on the
+ * head plus a release store into the previous node, the consumer walks the
+ * list from a stub node without any atomic read-modify-write. Nothing ever
+ * blocks, a push never fails. Values are meant to be batches, each push
+ * allocates one node.
+ *
+ * A value pushed while the previous producer is between its two steps only
+ * becomes visible once that producer finishes its push.
+ *
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    MpscQueue() : head_ {new Node {}}, tail_ {head_.load(std::memory_order_relaxed)} {}
+
+    ~MpscQueue()
+    {
+      while (tail_ != nullptr) {
+        auto next {tail_->next.load(std::memory_order_relaxed)};
+        delete tail_;
+        tail_ = next;
+      }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread
+    void push(T value)
+    {
+      auto node {new Node {{nullptr}, std::move(value)}};
+      auto previous {head_.exchange(node, std::memory_order_acq_rel)};
+      previous->next.store(node, std::memory_order_release);
+    }
+
+    // Consumer only
+    bool tryPop(T& value)
+    {
+      auto next {tail_->next.load(std::memory_order_acquire)};
+
+      if (next == nullptr)
+        return false;
+
+      value = std::move(next->value);
+      delete tail_;
+      tail_ = next;
+
+      return true;
+    }
+
+  private:
+    struct Node {
+      std::atomic<Node*> next {nullptr};
+      T value {};
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<Node*> head_;
+    alignas(CACHE_LINE_SIZE) Node* tail_;
+};
+}
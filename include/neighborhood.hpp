@@ -0,0 +1,99 @@
+/**
+ * @file neighborhood.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Compile-time neighborhood policies for the grid search
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <array>
+#include <utility>
+
+#include "node_dijkstra.hpp"
+
+#define ACTION_COST_KNIGHT 2.2
+
+namespace project2 {
+
+/**
+ * @brief A neighborhood is a set of constexpr move tables. mask_bit is the
+ * bit of each move in OccupancyGrid::getNeighborMask, or -1 when the mask
+ * doesn't cover that move and it has to be checked against the grid.
+ *
+ */
+struct FourConnected {
+  static constexpr std::size_t size {4};
+  static constexpr std::array<int, size> dx {0, 1, 0, -1};
+  static constexpr std::array<int, size> dy {1, 0, -1, 0};
+  static constexpr std::array<float, size> cost {
+    ACTION_COST_STRAIGHT, ACTION_COST_STRAIGHT, ACTION_COST_STRAIGHT, ACTION_COST_STRAIGHT};
+  static constexpr std::array<int, size> mask_bit {0, 2, 4, 6};
+};
+
+struct EightConnected {
+  static constexpr std::size_t size {8};
+  static constexpr std::array<int, size> dx {action_dx};
+  static constexpr std::array<int, size> dy {action_dy};
+  static constexpr std::array<float, size> cost {action_cost};
+  static constexpr std::array<int, size> mask_bit {0, 1, 2, 3, 4, 5, 6, 7};
+};
+
+struct SixteenConnected {
+  static constexpr std::size_t size {16};
+  static constexpr std::array<int, size> dx {
+    0, 1, 1, 1, 0, -1, -1, -1,
+    1, 2, 2, 1, -1, -2, -2, -1};
+  static constexpr std::array<int, size> dy {
+    1, 1, 0, -1, -1, -1, 0, 1,
+    2, 1, -1, -2, -2, -1, 1, 2};
+  static constexpr std::array<float, size> cost {
+    ACTION_COST_STRAIGHT, ACTION_COST_DIAGONAL, ACTION_COST_STRAIGHT, ACTION_COST_DIAGONAL,
+    ACTION_COST_STRAIGHT, ACTION_COST_DIAGONAL, ACTION_COST_STRAIGHT, ACTION_COST_DIAGONAL,
+    ACTION_COST_KNIGHT, ACTION_COST_KNIGHT, ACTION_COST_KNIGHT, ACTION_COST_KNIGHT,
+    ACTION_COST_KNIGHT, ACTION_COST_KNIGHT, ACTION_COST_KNIGHT, ACTION_COST_KNIGHT};
+  static constexpr std::array<int, size> mask_bit {
+    0, 1, 2, 3, 4, 5, 6, 7,
+    -1, -1, -1, -1, -1, -1, -1, -1};
+};
+
+/**
+ * @brief Calls visit(std::integral_constant<std::size_t, i>) for every move
+ * of the neighborhood. The index is a constant expression inside visit so
+ * the table lookups fold away and the loop is fully unrolled.
+ *
+ */
+template <typename Neighborhood, typename Visitor, std::size_t... I>
+inline void forEachMove(Visitor&& visit, std::index_sequence<I...>)
+{
+  (visit(std::integral_constant<std::size_t, I> {}), ...);
+}
+
+template <typename Neighborhood, typename Visitor>
+inline void forEachMove(Visitor&& visit)
+{
+  forEachMove<Neighborhood>(std::forward<Visitor>(visit),
+    std::make_index_sequence<Neighborhood::size> {});
+}
+
+/**
+ * @brief True when every move is one of the 8 neighbor steps. Such searches
+ * never leave an 8-connected component of free cells, while the knight
+ * moves can jump over thin walls.
+ *
+ */
+template <typename Neighborhood>
+constexpr bool staysInComponent()
+{
+  for (const auto& bit: Neighborhood::mask_bit) {
+    if (bit < 0)
+      return false;
+  }
+
+  return true;
+}
+
+}
@@ -13,13 +13,8 @@
 #include <iostream>
 #include <vector>
 #include <array>
+#include <cstdint>
 
-#define X_MIN_MM 0
-#define X_MAX_MM 1200
-#define Y_MIN_MM 0
-#define Y_MAX_MM 500
-
-#define ACTION_DISPLACEMENT_MM 1
 #define ACTION_COST_STRAIGHT 1.0
 #define ACTION_COST_DIAGONAL 1.4
 
@@ -46,6 +41,27 @@ const std::array<Action, 8> actions_list {
   Action::UP_LEFT
 };
 
+// Cell displacement and cost of each action, in actions_list order
+constexpr std::array<int, 8> action_dx {0, 1, 1, 1, 0, -1, -1, -1};
+constexpr std::array<int, 8> action_dy {1, 1, 0, -1, -1, -1, 0, 1};
+constexpr std::array<float, 8> action_cost {
+  ACTION_COST_STRAIGHT, ACTION_COST_DIAGONAL,
+  ACTION_COST_STRAIGHT, ACTION_COST_DIAGONAL,
+  ACTION_COST_STRAIGHT, ACTION_COST_DIAGONAL,
+  ACTION_COST_STRAIGHT, ACTION_COST_DIAGONAL};
+
+// splitmix64 finalizer, every input bit flips about half of the output bits
+constexpr std::uint64_t mixHash(std::uint64_t value)
+{
+  value ^= value >> 30;
+  value *= 0xBF58476D1CE4E5B9ULL;
+  value ^= value >> 27;
+  value *= 0x94D049BB133111EBULL;
+  value ^= value >> 31;
+
+  return value;
+}
+
 struct Position {
   Position()
   : x {0}, y {0} {}
@@ -53,9 +69,8 @@ struct Position {
   Position(unsigned int x_val, unsigned int y_val)
   : x {x_val}, y {y_val} {}
 
-  Position(const Position& position_val)
-  : x {position_val.x},
-    y {position_val.y} {}
+  Position(const Position& position_val) = default;
+  Position& operator=(const Position& position_val) = default;
 
   bool operator==(const Position& _position) const
   {
@@ -78,6 +93,108 @@ struct Position {
   unsigned int y {0};
 };
 
+/**
+ * @brief Map extent and resolution, given at runtime. Positions are in mm
+ * from the origin, cells are cell_size mm apart and both borders are cells.
+ *
+ */
+struct GridSpec {
+  GridSpec(unsigned int width_val, unsigned int height_val, unsigned int cell_size_val = 1)
+  : width {width_val}, height {height_val}, cell_size {cell_size_val} {}
+
+  unsigned int getColumns() const {return width / cell_size + 1;}
+  unsigned int getRows() const {return height / cell_size + 1;}
+  unsigned long getCellCount() const {return static_cast<unsigned long>(getColumns()) * getRows();}
+
+  bool contains(const Position& position) const
+  {
+    return (position.x / cell_size < getColumns() && position.y / cell_size < getRows());
+  }
+
+  unsigned long getIndex(const Position& position) const
+  {
+    return position.x / cell_size + static_cast<unsigned long>(getColumns()) * (position.y / cell_size);
+  }
+
+  Position getPosition(unsigned long index) const
+  {
+    return Position(static_cast<unsigned int>(index % getColumns()) * cell_size,
+                    static_cast<unsigned int>(index / getColumns()) * cell_size);
+  }
+
+  bool operator==(const GridSpec& grid_spec) const
+  {
+    return (width == grid_spec.width && height == grid_spec.height && cell_size == grid_spec.cell_size);
+  }
+
+  unsigned int width;
+  unsigned int height;
+  unsigned int cell_size;
+};
+
+/**
+ * @brief Same interface as GridSpec with the map size baked in at compile
+ * time, so index math folds into constant multiplies and shifts.
+ *
+ */
+template <unsigned int Width, unsigned int Height, unsigned int CellSize = 1>
+struct FixedGridSpec {
+  FixedGridSpec() {}
+  explicit FixedGridSpec(const GridSpec&) {}
+
+  static constexpr unsigned int width {Width};
+  static constexpr unsigned int height {Height};
+  static constexpr unsigned int cell_size {CellSize};
+
+  static constexpr unsigned int getColumns() {return Width / CellSize + 1;}
+  static constexpr unsigned int getRows() {return Height / CellSize + 1;}
+  static constexpr unsigned long getCellCount() {return static_cast<unsigned long>(getColumns()) * getRows();}
+
+  static constexpr bool contains(const Position& position)
+  {
+    return (position.x / CellSize < getColumns() && position.y / CellSize < getRows());
+  }
+
+  static constexpr unsigned long getIndex(const Position& position)
+  {
+    return position.x / CellSize + static_cast<unsigned long>(getColumns()) * (position.y / CellSize);
+  }
+
+  static Position getPosition(unsigned long index)
+  {
+    return Position(static_cast<unsigned int>(index % getColumns()) * CellSize,
+                    static_cast<unsigned int>(index / getColumns()) * CellSize);
+  }
+
+  bool operator==(const GridSpec& grid_spec) const
+  {
+    return (Width == grid_spec.width && Height == grid_spec.height && CellSize == grid_spec.cell_size);
+  }
+};
+
+/**
+ * @brief Open list entry of the grid search, 8 bytes. The rest of the node
+ * lives in per-cell side arrays: the best distance and one parent byte.
+ * Key is the distance type of the cost model, float or fixed-point.
+ *
+ */
+template <typename Key>
+struct BasicPackedNode {
+  Key key;
+  std::uint32_t index;
+
+  bool operator>(const BasicPackedNode& compare_node) const {return key > compare_node.key;}
+  bool operator<(const BasicPackedNode& compare_node) const {return key < compare_node.key;}
+};
+
+using PackedNode = BasicPackedNode<float>;
+
+// Parent byte: direction of the move into the cell (3 bits for the
+// 8-neighborhood, 4 for the 16-neighborhood) and the settled flag.
+constexpr std::uint8_t NODE_PARENT_MASK {0x0F};
+constexpr std::uint8_t NODE_NO_PARENT {0x7F};
+constexpr std::uint8_t NODE_CLOSED {0x80};
+
 class Node
 {
   public:
@@ -93,7 +210,6 @@ class Node
       float distance);
 
     void setDistance(float new_distance) {distance_ = new_distance;}
-    bool actionMove(Action action, Node& child_node);
 
     const project2::Position& getPosition() const {return position_;}
     const float getDistance() const {return distance_;}
@@ -161,10 +277,7 @@ namespace std {
   {
     unsigned long operator()(const project2::Position& position) const
     {
-      unsigned long x_hash {hash<int>()(position.x)};
-      unsigned long y_hash {hash<int>()(position.y)};
-
-      return x_hash ^ y_hash;
+      return project2::mixHash((static_cast<std::uint64_t>(position.x) << 32) | position.y);
     }
   };
 }
@@ -0,0 +1,138 @@
+/**
+ * @file occupancy_grid.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Declaration of the rasterized obstacle space
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "node_dijkstra.hpp"
+#include "grid_layout.hpp"
+
+namespace project2 {
+
+class Obstacle;
+struct Bounds;
+using ObstacleList = std::vector<std::shared_ptr<Obstacle>>;
+
+/**
+ * @brief Union of all the obstacles (clearance and map boundary included)
+ * rasterized once on the search grid. Overlapping obstacles cost nothing
+ * extra, every query is a single lookup. The valid moves out of every free
+ * cell are precomputed as well, so expansion needs no bounds or obstacle
+ * checks at all.
+ *
+ * Cell arrays are stored in the given layout, flat indices are layout indices.
+ *
+ * Free cells are also labeled with their 8-connected component, so whether
+ * two cells can reach each other at all is a single comparison.
+ *
+ * Obstacles can be added and removed while the map is live. An edit only
+ * rasterizes the cells in the bounds of the obstacle and relabels the
+ * components locally: a split relabels the smaller pieces, a merge floods
+ * the smaller components into the largest one. Component IDs are no longer
+ * dense after an edit. Edits must not overlap a search, and a distance field
+ * of the grid has to be rebuilt after them.
+ *
+ */
+class OccupancyGrid
+{
+  public:
+    OccupancyGrid(
+      const ObstacleList& obstacles,
+      const GridSpec& grid_spec,
+      GridLayout layout = GridLayout::ROW_MAJOR);
+
+    bool isBlocked(const Position& position) const {return blocked_[getIndex(position)];}
+    bool isBlocked(unsigned long index) const {return blocked_[index];}
+
+    // Cell coordinates, everything outside of the map counts as blocked
+    bool isBlocked(long cell_x, long cell_y) const
+    {
+      return (cell_x < 0 || cell_x >= width_ || cell_y < 0 || cell_y >= height_
+        || blocked_[getIndex(cell_x, cell_y)]);
+    }
+
+    // Bit i is set if actions_list[i] lands on a free cell inside the map
+    unsigned char getNeighborMask(const Position& position) const {return neighbor_masks_[getIndex(position)];}
+    unsigned char getNeighborMask(unsigned long index) const {return neighbor_masks_[index];}
+
+    // Component ID of a free cell, starting at 1. Blocked cells have 0.
+    std::uint32_t getComponent(const Position& position) const {return components_[getIndex(position)];}
+    std::uint32_t getComponent(unsigned long index) const {return components_[index];}
+    std::uint32_t getComponentCount() const {return component_count_;}
+    std::uint32_t getComponentSize(std::uint32_t component) const {return component_sizes_[component];}
+
+    bool isConnected(unsigned long index, unsigned long other_index) const
+    {
+      return components_[index] != 0 && components_[index] == components_[other_index];
+    }
+
+    unsigned long getIndex(const Position& position) const {return layout_.getIndex(position);}
+    unsigned long getIndex(long cell_x, long cell_y) const {return layout_.getIndex(cell_x, cell_y);}
+
+    GridLayout getLayout() const {return layout_.kind;}
+
+    // Hash of the grid spec, layout and blocked cells. Grids built from the
+    // same obstacles share it, every edit that changes a cell changes it.
+    std::uint64_t getVersion() const {return version_;}
+
+    // Blocks the free cells the new obstacle covers
+    void addObstacle(const Obstacle& obstacle);
+
+    // Frees the cells of the obstacle that none of the remaining ones cover
+    void removeObstacle(const Obstacle& obstacle, const ObstacleList& remaining_obstacles);
+
+    const GridSpec& getGridSpec() const {return grid_spec_;}
+    unsigned int getWidth() const {return width_;}
+    unsigned int getHeight() const {return height_;}
+    unsigned long size() const {return blocked_.size();}
+
+  private:
+    void computeNeighborMasks();
+    unsigned char computeNeighborMask(long cell_x, long cell_y) const;
+    void computeComponents();
+
+    // Layout indices of the map cells inside bounds that pass test
+    template <typename Test>
+    std::vector<unsigned long> findCells(const Bounds& bounds, Test&& test) const;
+
+    // findCells over the bounds of obstacle and its boundary band, each cell once
+    template <typename Test>
+    std::vector<unsigned long> findObstacleCells(const Obstacle& obstacle, Test&& test) const;
+
+    unsigned long getNeighbor(unsigned long index, unsigned int action) const
+    {
+      return getIndex(layout_.getCellX(index) + action_dx[action], layout_.getCellY(index) + action_dy[action]);
+    }
+
+    void blockCells(const std::vector<unsigned long>& cells);
+    void freeCells(const std::vector<unsigned long>& cells);
+    void updateNeighborMasks(const std::vector<unsigned long>& cells);
+    void splitComponent(const std::vector<unsigned long>& seeds);
+    void relabelComponent(unsigned long seed, std::uint32_t component);
+
+    std::uint32_t allocateComponent();
+    void releaseComponent(std::uint32_t component);
+
+    GridSpec grid_spec_;
+    DynamicLayout layout_;
+    unsigned int width_;
+    unsigned int height_;
+    std::vector<unsigned char> blocked_;
+    std::vector<unsigned char> neighbor_masks_;
+    std::vector<std::uint32_t> components_;
+    std::uint32_t component_count_;
+    std::vector<std::uint32_t> component_sizes_;
+    std::vector<std::uint32_t> free_components_;
+    std::uint64_t version_;
+};
+}
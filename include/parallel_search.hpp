@@ -0,0 +1,360 @@
+/**
+ * @file parallel_search.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Hash-distributed parallel Dijkstra search (HDA*) on the grid
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include "grid_search.hpp"
+#include "mpsc_queue.hpp"
+
+// Runs of 2^PARALLEL_OWNER_BLOCK_BITS storage indices share an owner thread,
+// 16 floats of distances fill one cache line
+#define PARALLEL_OWNER_BLOCK_BITS 4
+
+// Children buffered per destination thread before they are sent
+#define PARALLEL_BATCH_SIZE 128
+
+// Expansions between two looks at the inbox
+#define PARALLEL_INBOX_INTERVAL 64
+
+// How far, in cost, a thread may expand ahead of the lowest key of all threads
+#define PARALLEL_KEY_WINDOW 8.0F
+
+// Rounds without work a thread yields for before it starts sleeping
+#define PARALLEL_IDLE_YIELDS 64
+
+// Sleep of a thread that stayed without work, in microseconds
+#define PARALLEL_IDLE_SLEEP_US 50
+
+namespace project2 {
+
+struct ParallelSearchStats {
+  unsigned long expansions {0};
+
+  // Expansions beyond the first of each cell
+  unsigned long reexpansions {0};
+
+  // Children sent to another thread
+  unsigned long messages {0};
+};
+
+namespace detail {
+
+template <typename Distance>
+struct ChildMessage {
+  Distance distance;
+  std::uint32_t index;
+  std::uint8_t move;
+};
+
+// Yields while work may be close, then sleeps so an idle thread stops taking
+// the core from the ones that have work
+class IdleBackoff
+{
+  public:
+    void wait()
+    {
+      if (rounds_ < PARALLEL_IDLE_YIELDS) {
+        rounds_++;
+        std::this_thread::yield();
+      }
+      else {
+        std::this_thread::sleep_for(std::chrono::microseconds {PARALLEL_IDLE_SLEEP_US});
+      }
+    }
+
+    void reset() {rounds_ = 0;}
+
+  private:
+    unsigned int rounds_ {0};
+};
+
+}
+
+/**
+ * @brief planPath on thread_count threads, HDA* style with a zero
+ * heuristic. Every cell has an owner thread picked by hashing its storage
+ * index (mixHash of runs of 2^PARALLEL_OWNER_BLOCK_BITS cells). Only the owner
+ * touches a cell's workspace entries and holds it in its own open list, a
+ * thread that generates a child of another thread sends it there in batches
+ * through the owner's lock-free MPSC queue.
+ *
+ * Threads don't settle cells in global order, so a cell can be improved and
+ * expanded again after its first expansion. To keep that rare a thread only
+ * expands up to PARALLEL_KEY_WINDOW above the lowest key of all threads, each
+ * thread publishing the top of its open list and a lower bound of its inbox.
+ * The window only paces the threads, it doesn't affect the result. The goal's best distance so far
+ * is shared as an atomic incumbent and nothing at or above it is expanded.
+ * The search ends once no thread has a node below the incumbent and no
+ * message is in flight, then the incumbent is optimal. That is detected with
+ * one counter of active threads plus unprocessed messages: a message is
+ * counted before it is sent, an idle thread that receives one counts itself
+ * active before the message is uncounted, so the counter only reaches zero
+ * when nothing is left that could create work.
+ *
+ * A thread without work yields, then sleeps PARALLEL_IDLE_SLEEP_US at a time
+ * until a message or the end of the search comes. The path ends up in
+ * workspace.getPath(). The caller's thread is one of the workers.
+ *
+ */
+template <typename Neighborhood, typename Spec = GridSpec, typename Layout = RowMajorLayout<Spec>,
+  typename Cost = FloatCost>
+SearchStatus planPathParallel(
+  const Position& start,
+  const Position& goal,
+  const OccupancyGrid& occupancy_grid,
+  BasicPlannerWorkspace<typename Cost::value_type>& workspace,
+  unsigned int thread_count,
+  const DistanceField* clearance_cost = nullptr,
+  ParallelSearchStats* stats = nullptr)
+{
+  using Distance = typename Cost::value_type;
+  using Message = detail::ChildMessage<Distance>;
+  using Batch = std::vector<Message>;
+
+  const Layout layout {occupancy_grid.getGridSpec()};
+
+  if (!(layout.spec == occupancy_grid.getGridSpec()) || Layout::kind != occupancy_grid.getLayout())
+    return SearchStatus::INVALID_GRID;
+
+  if (!layout.spec.contains(start) || !layout.spec.contains(goal)) {
+    workspace.getPath().clear();
+    return SearchStatus::OUT_OF_BOUNDS;
+  }
+
+  workspace.reset(layout.getStorageSize());
+  thread_count = std::max(thread_count, 1U);
+
+  const auto start_index {layout.getIndex(start)};
+  const auto goal_index {layout.getIndex(goal)};
+
+  if constexpr (staysInComponent<Neighborhood>()) {
+    if (!occupancy_grid.isConnected(start_index, goal_index))
+      return SearchStatus::NO_PATH;
+  }
+
+  auto getOwner {[thread_count](unsigned long index) {
+    return static_cast<unsigned int>(mixHash(index >> PARALLEL_OWNER_BLOCK_BITS) % thread_count);
+  }};
+
+  struct alignas(CACHE_LINE_SIZE) Worker {
+    BasicOpenList<Distance> open_list {};
+    MpscQueue<Batch> inbox {};
+    ParallelSearchStats stats {};
+
+    // Lowest key of the open list, infinity while idle
+    std::atomic<Distance> frontier_key {Cost::infinity};
+
+    // Lower bound of the keys waiting in the inbox
+    std::atomic<Distance> inbox_key {Cost::infinity};
+  };
+
+  std::vector<std::unique_ptr<Worker>> workers (thread_count);
+  for (auto& worker: workers)
+    worker = std::make_unique<Worker>();
+
+  std::atomic<Distance> incumbent {Cost::infinity};
+  std::atomic<long> pending {static_cast<long>(thread_count)};
+  std::atomic<bool> done {false};
+  constexpr Distance key_window {Cost::fromFloat(PARALLEL_KEY_WINDOW)};
+
+  auto getFrontierKey {[&workers]() {
+    Distance frontier_key {Cost::infinity};
+
+    for (const auto& worker: workers) {
+      frontier_key = std::min(frontier_key, worker->frontier_key.load(std::memory_order_relaxed));
+      frontier_key = std::min(frontier_key, worker->inbox_key.load(std::memory_order_relaxed));
+    }
+
+    return frontier_key;
+  }};
+
+  // Only ever called by the owner of index
+  auto relax {[&](Worker& worker, unsigned long index, Distance distance, std::uint8_t move) {
+    if (!(distance < workspace.getDistance(index)))
+      return;
+
+    workspace.setNode(index, distance, move);
+    worker.open_list.push({distance, static_cast<std::uint32_t>(index)});
+
+    if (index == goal_index)
+      detail::lowerBound(incumbent, distance);
+  }};
+
+  relax(*workers[getOwner(start_index)], start_index, Cost::fromFloat(0.F), NODE_NO_PARENT);
+
+  auto runWorker {[&](unsigned int id) {
+    auto& worker {*workers[id]};
+    std::vector<Batch> outboxes (thread_count);
+    Batch batch {};
+    bool active {true};
+    detail::IdleBackoff backoff {};
+
+    auto send {[&](unsigned int owner) {
+      Distance lowest_key {Cost::infinity};
+      for (const auto& message: outboxes[owner])
+        lowest_key = std::min(lowest_key, message.distance);
+
+      detail::lowerBound(workers[owner]->inbox_key, lowest_key);
+      pending.fetch_add(static_cast<long>(outboxes[owner].size()), std::memory_order_acq_rel);
+      worker.stats.messages += outboxes[owner].size();
+      workers[owner]->inbox.push(std::move(outboxes[owner]));
+      outboxes[owner] = Batch {};
+      outboxes[owner].reserve(PARALLEL_BATCH_SIZE);
+    }};
+
+    for (auto& outbox: outboxes)
+      outbox.reserve(PARALLEL_BATCH_SIZE);
+
+    auto flushOutboxes {[&]() {
+      for (unsigned int owner {0}; owner < thread_count; owner++) {
+        if (!outboxes[owner].empty())
+          send(owner);
+      }
+    }};
+
+    // Expands up to PARALLEL_INBOX_INTERVAL nodes below bound and not above limit
+    auto expandBatch {[&](Distance bound, Distance limit) {
+      auto& open_list {worker.open_list};
+
+      for (unsigned int expanded {0}; expanded < PARALLEL_INBOX_INTERVAL && !open_list.empty(); expanded++) {
+        const auto current_node {open_list.top()};
+
+        if (!(current_node.key < bound) || limit < current_node.key)
+          return;
+
+        open_list.pop();
+
+        if (workspace.getDistance(current_node.index) < current_node.key)
+          continue;
+
+        workspace.close(current_node.index);
+        worker.stats.expansions++;
+
+        const unsigned long index {current_node.index};
+
+        forEachChild<Neighborhood>(index, layout.getCellX(index), layout.getCellY(index), occupancy_grid, layout,
+          [&](unsigned long child_index, auto move) {
+            const auto child_distance {getChildDistance<Neighborhood, Cost>(current_node.key, move, child_index,
+              clearance_cost)};
+            const auto owner {getOwner(child_index)};
+
+            if (owner == id) {
+              relax(worker, child_index, child_distance, decltype(move)::value);
+              return;
+            }
+
+            outboxes[owner].push_back({child_distance, static_cast<std::uint32_t>(child_index), decltype(move)::value});
+
+            if (outboxes[owner].size() >= PARALLEL_BATCH_SIZE)
+              send(owner);
+          });
+      }
+    }};
+
+    while (true) {
+      worker.inbox_key.store(Cost::infinity, std::memory_order_relaxed);
+
+      while (worker.inbox.tryPop(batch)) {
+        backoff.reset();
+
+        if (!active) {
+          pending.fetch_add(1, std::memory_order_acq_rel);
+          active = true;
+        }
+
+        for (const auto& message: batch)
+          relax(worker, message.index, message.distance, message.move);
+
+        pending.fetch_sub(static_cast<long>(batch.size()), std::memory_order_acq_rel);
+      }
+
+      if (active) {
+        auto& open_list {worker.open_list};
+
+        // Stale entries of nodes that were improved after being pushed
+        while (!open_list.empty() && workspace.getDistance(open_list.top().index) < open_list.top().key)
+          open_list.pop();
+
+        const auto bound {incumbent.load(std::memory_order_relaxed)};
+
+        if (!open_list.empty() && open_list.top().key < bound) {
+          worker.frontier_key.store(open_list.top().key, std::memory_order_relaxed);
+
+          const auto limit {Cost::add(getFrontierKey(), key_window)};
+
+          if (!(limit < open_list.top().key)) {
+            expandBatch(bound, limit);
+            flushOutboxes();
+            backoff.reset();
+            continue;
+          }
+
+          // Too far ahead of the other threads, let them catch up
+          flushOutboxes();
+          backoff.wait();
+          continue;
+        }
+
+        // Nothing below the incumbent left here, hand over what is buffered
+        flushOutboxes();
+        worker.frontier_key.store(Cost::infinity, std::memory_order_relaxed);
+        active = false;
+
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+          done.store(true, std::memory_order_release);
+      }
+
+      if (done.load(std::memory_order_acquire))
+        return;
+
+      backoff.wait();
+    }
+  }};
+
+  std::vector<std::thread> threads {};
+  for (unsigned int id {1}; id < thread_count; id++)
+    threads.emplace_back(runWorker, id);
+
+  runWorker(0);
+
+  for (auto& thread: threads)
+    thread.join();
+
+  if (stats != nullptr) {
+    *stats = {};
+
+    for (const auto& worker: workers) {
+      stats->expansions += worker->stats.expansions;
+      stats->messages += worker->stats.messages;
+    }
+
+    // An improvement clears the closed flag, every cell expanded since keeps it
+    unsigned long expanded_cells {0};
+    for (unsigned long index {0}; index < layout.getStorageSize(); index++)
+      expanded_cells += workspace.isClosed(index);
+
+    stats->reexpansions = stats->expansions - expanded_cells;
+  }
+
+  if (!(incumbent.load() < Cost::infinity))
+    return SearchStatus::NO_PATH;
+
+  backtrackPath<Neighborhood>(start_index, goal_index, layout, workspace);
+
+  return SearchStatus::FOUND;
+}
+}
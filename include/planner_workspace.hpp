@@ -0,0 +1,89 @@
+/**
+ * @file planner_workspace.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Declaration of the reusable per-query search buffers
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <memory_resource>
+#include <limits>
+#include <cstdint>
+
+#include "project2.hpp"
+
+namespace project2 {
+
+/**
+ * @brief Owns every buffer a grid search needs. A cell's entries are only
+ * valid when its generation stamp matches the current query, so starting a
+ * new query is a counter increment instead of clearing O(W*H) memory. Kept
+ * across queries it stops allocating once it has grown to the largest map
+ * and open list seen. Every buffer is taken from the memory resource given at
+ * construction, e.g. a per-query SearchArena.
+ *
+ * Distance is the value type of the cost model, float or fixed-point.
+ *
+ */
+template <typename Distance>
+class BasicPlannerWorkspace
+{
+  public:
+    // Distance of the cells the query hasn't reached
+    static constexpr Distance unreached {std::numeric_limits<Distance>::has_infinity
+      ? std::numeric_limits<Distance>::infinity() : std::numeric_limits<Distance>::max()};
+
+    explicit BasicPlannerWorkspace(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+    BasicPlannerWorkspace(
+      unsigned long cell_count,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+    // Starts a new query, O(1) unless the map is bigger than any before
+    void reset(unsigned long cell_count);
+
+    bool isVisited(unsigned long index) const {return generations_[index] == generation_;}
+    bool isClosed(unsigned long index) const {return isVisited(index) && (parents_[index] & NODE_CLOSED);}
+
+    Distance getDistance(unsigned long index) const
+    {
+      return isVisited(index) ? distances_[index] : unreached;
+    }
+
+    std::uint8_t getParent(unsigned long index) const
+    {
+      return isVisited(index) ? parents_[index] : NODE_NO_PARENT;
+    }
+
+    void setNode(unsigned long index, Distance distance, std::uint8_t parent)
+    {
+      generations_[index] = generation_;
+      distances_[index] = distance;
+      parents_[index] = parent;
+    }
+
+    void close(unsigned long index) {parents_[index] |= NODE_CLOSED;}
+
+    BasicOpenList<Distance>& getOpenList() {return open_list_;}
+    std::pmr::vector<Position>& getPath() {return path_;}
+    const std::pmr::vector<Position>& getPath() const {return path_;}
+
+  private:
+    std::uint32_t generation_;
+    std::pmr::vector<std::uint32_t> generations_;
+    std::pmr::vector<Distance> distances_;
+    std::pmr::vector<std::uint8_t> parents_;
+    BasicOpenList<Distance> open_list_;
+    std::pmr::vector<Position> path_;
+};
+
+using PlannerWorkspace = BasicPlannerWorkspace<float>;
+using FixedPlannerWorkspace = BasicPlannerWorkspace<std::uint32_t>;
+
+extern template class BasicPlannerWorkspace<float>;
+extern template class BasicPlannerWorkspace<std::uint32_t>;
+}
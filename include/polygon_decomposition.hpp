@@ -0,0 +1,54 @@
+/**
+ * @file polygon_decomposition.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Declaration of the convex decomposition of simple polygons
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <vector>
+
+namespace project2 {
+
+/**
+ * @brief Polygons are flat {x1, y1, x2, y2, ...} lists like the rest of the
+ * project, without the closing point repeated.
+ *
+ */
+using PolygonPoints = std::vector<unsigned int>;
+
+bool isConvexPolygon(const PolygonPoints& points);
+
+/**
+ * @brief Removes a repeated closing point, duplicate and collinear vertices
+ * and makes the polygon counter-clockwise.
+ *
+ */
+PolygonPoints normalizePolygon(const PolygonPoints& points);
+
+/**
+ * @brief Ear clipping triangulation of a simple counter-clockwise polygon.
+ * Ears are only tested against the reflex vertices and only the two
+ * neighbors of a clipped ear are tested again, O(n * r) for r reflex
+ * vertices.
+ *
+ * @return Triangles as indices into the polygon vertices, none for fewer
+ * than three vertices
+ */
+std::vector<std::vector<unsigned int>> triangulatePolygon(const PolygonPoints& points);
+
+/**
+ * @brief Hertel-Mehlhorn convex decomposition: triangulate, then drop every
+ * diagonal that is not needed to keep both of its neighbors convex, in one
+ * pass over a map of the piece edges. Produces at most four times the
+ * optimal number of pieces, and no pieces for a polygon with fewer than
+ * three vertices.
+ *
+ */
+std::vector<PolygonPoints> decomposeConvex(const PolygonPoints& points);
+
+}
@@ -12,12 +12,21 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <queue>
 #include <functional>
 #include <chrono>
+#include <memory>
+#include <memory_resource>
+#include <atomic>
 
 #include "shapes.hpp"
 #include "node_dijkstra.hpp"
+#include "distance_field.hpp"
+#include "occupancy_grid.hpp"
+#include "spsc_ring_buffer.hpp"
+#include "search_limits.hpp"
+#include "polygon_decomposition.hpp"
 
 namespace project2 {
 
@@ -50,56 +59,191 @@ struct TwoPoints {
 
 };
 
-class OpenList : public std::priority_queue<project2::Node,
-                                             std::vector<project2::Node>,
-                                             std::greater<project2::Node>>
+/**
+ * @brief Min-heap of packed nodes. Improved nodes are pushed again instead of
+ * searched for and replaced, stale entries are skipped when popped. The heap
+ * storage comes from the given memory resource.
+ *
+ */
+template <typename Key>
+class BasicOpenList : public std::priority_queue<project2::BasicPackedNode<Key>,
+                                                  std::pmr::vector<project2::BasicPackedNode<Key>>,
+                                                  std::greater<project2::BasicPackedNode<Key>>>
 {
   public:
-    OpenList();
+    explicit BasicOpenList(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    : std::priority_queue<project2::BasicPackedNode<Key>,
+                          std::pmr::vector<project2::BasicPackedNode<Key>>,
+                          std::greater<project2::BasicPackedNode<Key>>> (
+        std::greater<project2::BasicPackedNode<Key>> {},
+        std::pmr::vector<project2::BasicPackedNode<Key>> (resource))
+    {}
+
+    void reserve(unsigned long capacity) {this->c.reserve(capacity);}
+    void clear() {this->c.clear();}
+};
 
-    auto find(const project2::Node& node) {return std::find(c.begin(), c.end(), node);}
-    void erase(const std::vector<project2::Node>::iterator& node) {c.erase(node);}
-    auto end() {return c.end();}
+using OpenList = BasicOpenList<float>;
+
+// Axis-aligned box in map coordinates (mm)
+struct Bounds {
+  float x_min;
+  float y_min;
+  float x_max;
+  float y_max;
 };
 
-class ObstacleSpace
+/**
+ * @brief Common interface of the obstacle types. The map boundary, inflated
+ * by the clearance, is part of every obstacle.
+ *
+ */
+class Obstacle
+{
+  public:
+    Obstacle(
+      unsigned int clearance,
+      const GridSpec& grid_spec);
+
+    virtual ~Obstacle() = default;
+
+    virtual bool containsPoint(const Position& position) const = 0;
+
+    // Box around the inflated obstacle, the shared boundary band left out.
+    // Lets map edits test only the cells the obstacle can cover.
+    virtual Bounds getBounds() const = 0;
+
+    // Strips along the four map edges that hold the boundary band
+    std::array<Bounds, 4> getBoundaryBounds() const
+    {
+      const auto width {static_cast<float>(grid_spec_.width)};
+      const auto height {static_cast<float>(grid_spec_.height)};
+      const auto clearance {static_cast<float>(clearance_)};
+
+      return {{
+        {0.F, 0.F, width, clearance},
+        {0.F, height - clearance, width, height},
+        {0.F, 0.F, clearance, height},
+        {width - clearance, 0.F, width, height}}};
+    }
+
+    // Convex outlines for rendering only, the search never uses them.
+    virtual std::vector<PolygonPoints> getDisplayPolygons() const = 0;
+
+  protected:
+    bool inBoundaryClearance(const Position& position) const
+    {
+      return (position.x < 0 + clearance_ || position.x > grid_spec_.width - clearance_
+        || position.y < 0 + clearance_ || position.y > grid_spec_.height - clearance_);
+    }
+
+    unsigned int clearance_;
+    GridSpec grid_spec_;
+};
+
+/**
+ * @brief Obstacle built from a simple polygon. Non-convex polygons are split
+ * into convex pieces on construction since the half-plane test in
+ * containsPoint only holds for convex ones.
+ *
+ */
+class ObstacleSpace : public Obstacle
 {
   public:
     ObstacleSpace(
       const std::vector<unsigned int>& points,
       unsigned int clearance,
-      const TwoDE::vec2ui& view_size);
+      const GridSpec& grid_spec);
 
-    bool containsPoint(const Position& position);
+    bool containsPoint(const Position& position) const override;
+    Bounds getBounds() const override;
+
+    std::vector<PolygonPoints> getDisplayPolygons() const override {return convex_polygons_;}
+    const std::vector<PolygonPoints>& getConvexPolygons() const {return convex_polygons_;}
 
   private:
-    void getCoefficients(const std::vector<unsigned int>& points);
-    std::vector<project2::TwoPoints> lines_;
-    unsigned int clearance_;
-    TwoDE::vec2ui view_size_;
+    void getCoefficients(const std::vector<unsigned int>& points, bool bevel_corners);
+    std::vector<PolygonPoints> convex_polygons_;
+    std::vector<std::vector<project2::TwoPoints>> convex_lines_;
+};
+
+/**
+ * @brief Round column, a single distance test instead of a fine polygon.
+ *
+ */
+class CircleObstacle : public Obstacle
+{
+  public:
+    CircleObstacle(
+      const TwoDE::vec2ui& center,
+      unsigned int radius,
+      unsigned int clearance,
+      const GridSpec& grid_spec,
+      unsigned int display_segments = 32);
+
+    bool containsPoint(const Position& position) const override;
+    Bounds getBounds() const override;
+    std::vector<PolygonPoints> getDisplayPolygons() const override;
+
+  private:
+    float center_x_;
+    float center_y_;
+    float radius_;
+    float inflated_radius_sq_;
+    unsigned int display_segments_;
+};
+
+/**
+ * @brief Rotated ellipse. The clearance is tested against the exact distance
+ * to the boundary, found by bisection for the points between the ellipse and
+ * the box around its clearance band.
+ *
+ */
+class EllipseObstacle : public Obstacle
+{
+  public:
+    EllipseObstacle(
+      const TwoDE::vec2ui& center,
+      unsigned int radius_x,
+      unsigned int radius_y,
+      float angle,
+      unsigned int clearance,
+      const GridSpec& grid_spec,
+      unsigned int display_segments = 32);
+
+    bool containsPoint(const Position& position) const override;
+    Bounds getBounds() const override;
+    std::vector<PolygonPoints> getDisplayPolygons() const override;
+
+  private:
+    float center_x_;
+    float center_y_;
+    float radius_x_;
+    float radius_y_;
+    float angle_;
+    float cos_angle_;
+    float sin_angle_;
+    float radius_x_inv_sq_;
+    float radius_y_inv_sq_;
+    unsigned int display_segments_;
 };
 
 void initializeGLFW();
 void initializeGL();
 
-bool searchDijkstra(
+SearchStatus searchDijkstra(
   Node& start_node,
   Node& goal_node,
-  std::vector<ObstacleSpace>& obstacles,
-  std::deque<TwoDE::vec2ui>& explored_nodes,
+  const OccupancyGrid& occupancy_grid,
+  SpscRingBuffer<TwoDE::vec2ui>& explored_nodes,
   std::deque<TwoDE::vec2ui>& backtracked_path,
-  const bool& continue_search,
-  bool& search_complete);
+  const SearchLimits& limits,
+  std::atomic<bool>& search_complete,
+  const DistanceField* clearance_cost = nullptr);
 
 bool inObstacleSpace(
   const Position& point,
-  std::vector<ObstacleSpace>& obstacles_space);
-
-void backtrackPath(
-  const project2::Node& start_node,
-  const project2::Node& goal_node,
-  const std::unordered_map<project2::Position, project2::Node>& closed_list,
-  std::deque<TwoDE::vec2ui>& backtracked_path);
+  const ObstacleList& obstacles_space);
 
 unsigned int initShader();
 
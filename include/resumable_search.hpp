@@ -0,0 +1,113 @@
+/**
+ * @file resumable_search.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Single-source search that keeps its tree while the goal changes
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "grid_search.hpp"
+
+namespace project2 {
+
+/**
+ * @brief planPath from a fixed start to goals that keep changing. The
+ * settled cells and the open list of the last query stay in the workspace:
+ * Dijkstra's settled distances from the same start don't depend on the goal,
+ * so a goal that is settled already is answered by backtracking alone, any
+ * other goal continues the search from the saved frontier.
+ *
+ * The tree is grown on one version of the map (OccupancyGrid::getVersion)
+ * and started over once the grid has been edited, or when the start moves.
+ * A query stopped by its limits keeps everything it settled, its partial
+ * path leads to the closest cell settled in that query.
+ *
+ */
+template <typename Neighborhood, typename Spec = GridSpec, typename Layout = RowMajorLayout<Spec>,
+  typename Cost = FloatCost>
+class ResumableSearch
+{
+  public:
+    using Distance = typename Cost::value_type;
+
+    ResumableSearch(
+      const Position& start,
+      const OccupancyGrid& occupancy_grid,
+      const DistanceField* clearance_cost = nullptr)
+    : occupancy_grid_ {occupancy_grid},
+      clearance_cost_ {clearance_cost},
+      start_ {start},
+      workspace_ {},
+      version_ {0},
+      grown_ {false},
+      expansions_ {0}
+    {}
+
+    // The next query starts a new tree from start
+    void setStart(const Position& start)
+    {
+      start_ = start;
+      grown_ = false;
+    }
+
+    // Path to goal into getPath(), with the status planPath would report
+    SearchStatus planPath(const Position& goal, const SearchLimits& limits = SearchLimits {})
+    {
+      GridSearch<Neighborhood, Layout, Cost> search {start_, goal, occupancy_grid_, workspace_, clearance_cost_,
+        limits};
+      SearchStatus status {};
+
+      if (grown_ && version_ == occupancy_grid_.getVersion()) {
+        status = search.resume();
+      }
+      else {
+        status = search.start();
+        grown_ = status != SearchStatus::INVALID_GRID && status != SearchStatus::OUT_OF_BOUNDS;
+        version_ = occupancy_grid_.getVersion();
+        expansions_ = 0;
+      }
+
+      while (status == SearchStatus::RUNNING)
+        status = search.settleNext([](unsigned long) {});
+
+      expansions_ += search.getExpansions();
+
+      return search.finish(status);
+    }
+
+    // Whether goal is answered without expanding anything
+    bool isSettled(const Position& goal) const
+    {
+      return grown_ && version_ == occupancy_grid_.getVersion() && occupancy_grid_.getGridSpec().contains(goal)
+        && workspace_.isClosed(occupancy_grid_.getIndex(goal));
+    }
+
+    // Cost of the path to a settled goal, unreached off the grid
+    Distance getDistance(const Position& goal) const
+    {
+      return occupancy_grid_.getGridSpec().contains(goal)
+        ? workspace_.getDistance(occupancy_grid_.getIndex(goal)) : BasicPlannerWorkspace<Distance>::unreached;
+    }
+
+    const std::pmr::vector<Position>& getPath() const {return workspace_.getPath();}
+
+    // Cells settled since the tree was started
+    unsigned long getExpansions() const {return expansions_;}
+
+  private:
+    const OccupancyGrid& occupancy_grid_;
+    const DistanceField* clearance_cost_;
+    Position start_;
+    BasicPlannerWorkspace<Distance> workspace_;
+    std::uint64_t version_;
+    bool grown_;
+    unsigned long expansions_;
+};
+
+}
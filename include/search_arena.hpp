@@ -0,0 +1,54 @@
+/**
+ * @file search_arena.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Declaration of the per-query monotonic allocation arena
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+
+#define SEARCH_ARENA_SLAB_BYTES (16UL << 20)
+
+namespace project2 {
+
+/**
+ * @brief Monotonic memory resource for everything a single query allocates.
+ * Allocation is a pointer bump, deallocation a no-op, and release() frees
+ * all of it at once.
+ *
+ * The first arena alive on a thread bumps through a thread-local slab that
+ * is kept for the lifetime of the thread, so steady-state queries never
+ * reach the global operator new. Arenas created while another one holds the
+ * slab, and requests beyond the slab, fall back to the upstream resource.
+ *
+ */
+class SearchArena
+{
+  public:
+    explicit SearchArena(
+      std::size_t slab_size = SEARCH_ARENA_SLAB_BYTES,
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+    ~SearchArena();
+
+    SearchArena(const SearchArena&) = delete;
+    SearchArena& operator=(const SearchArena&) = delete;
+
+    std::pmr::memory_resource* getResource() {return &*buffer_;}
+
+    // Invalidates everything allocated from the arena
+    void release() {buffer_->release();}
+
+    bool usesThreadSlab() const {return owns_slab_;}
+
+  private:
+    bool owns_slab_;
+    std::optional<std::pmr::monotonic_buffer_resource> buffer_;
+};
+}
@@ -0,0 +1,93 @@
+/**
+ * @file search_limits.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Cancellation, deadline and expansion budget of a search
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+// Expansions between two looks at the stop token and the clock
+#define SEARCH_CHECK_INTERVAL 1024
+
+namespace project2 {
+
+enum class SearchStatus {
+  FOUND = 0,
+  NO_PATH = 1,
+  CANCELLED = 2,
+  DEADLINE = 3,
+  EXPANSION_LIMIT = 4,
+  INVALID_GRID = 5,
+  RUNNING = 6,
+  FAILED = 7,
+  OUT_OF_BOUNDS = 8
+};
+
+inline const char* toString(SearchStatus status)
+{
+  switch (status) {
+    case SearchStatus::FOUND:
+      return "found";
+    case SearchStatus::NO_PATH:
+      return "no path";
+    case SearchStatus::CANCELLED:
+      return "cancelled";
+    case SearchStatus::DEADLINE:
+      return "deadline passed";
+    case SearchStatus::EXPANSION_LIMIT:
+      return "expansion limit reached";
+    case SearchStatus::RUNNING:
+      return "running";
+    case SearchStatus::FAILED:
+      return "failed with an exception";
+    case SearchStatus::OUT_OF_BOUNDS:
+      return "start or goal off the grid";
+    default:
+      return "grid doesn't match the search";
+  }
+}
+
+/**
+ * @brief When a search has to give up. The stop token is set by another
+ * thread to cancel. The token and the clock are only looked at every
+ * check_interval expansions, the expansion budget is exact.
+ *
+ */
+struct SearchLimits {
+  using Clock = std::chrono::steady_clock;
+
+  const std::atomic<bool>* stop_token {nullptr};
+  Clock::time_point deadline {Clock::time_point::max()};
+  unsigned long max_expansions {std::numeric_limits<unsigned long>::max()};
+  unsigned long check_interval {SEARCH_CHECK_INTERVAL};
+
+  // Expansion count of the next check after the one at expansions
+  unsigned long getNextCheck(unsigned long expansions) const
+  {
+    return expansions + check_interval < max_expansions ? expansions + check_interval : max_expansions;
+  }
+
+  // RUNNING if the search may go on
+  SearchStatus check(unsigned long expansions) const
+  {
+    if (stop_token != nullptr && stop_token->load(std::memory_order_relaxed))
+      return SearchStatus::CANCELLED;
+
+    if (expansions >= max_expansions)
+      return SearchStatus::EXPANSION_LIMIT;
+
+    if (deadline != Clock::time_point::max() && Clock::now() >= deadline)
+      return SearchStatus::DEADLINE;
+
+    return SearchStatus::RUNNING;
+  }
+};
+}
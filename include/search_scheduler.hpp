@@ -0,0 +1,81 @@
+/**
+ * @file search_scheduler.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Declaration of the round-robin scheduler of stepped searches
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+#include "stepped_search.hpp"
+
+namespace project2 {
+
+/**
+ * @brief Runs many stepped searches on a few worker threads. A worker takes
+ * the search at the front of the queue, resumes it for one step and puts it
+ * back at the end unless it is done, so every query in flight keeps moving
+ * and a long one can't hold a thread for its whole run.
+ *
+ * The callback of a search is called on whichever worker ran the step, never
+ * on two at once. A search or callback that throws ends that search only:
+ * the callback gets a last FAILED step and the worker moves on. Searches
+ * still in flight when the scheduler is destroyed are cancelled: their
+ * callback gets a last CANCELLED step and they stop counting as in flight.
+ * Workspaces belong to the caller, one per search in flight.
+ *
+ */
+class SearchScheduler
+{
+  public:
+    using StepCallback = std::function<void(const SearchStep&)>;
+
+    explicit SearchScheduler(unsigned int thread_count = std::thread::hardware_concurrency());
+    ~SearchScheduler();
+
+    SearchScheduler(const SearchScheduler&) = delete;
+    SearchScheduler& operator=(const SearchScheduler&) = delete;
+
+    void submit(SearchGenerator search, StepCallback on_step = {});
+
+    // Blocks until every submitted search has finished
+    void wait();
+
+    unsigned long getInFlight() const;
+    unsigned long getFailedCount() const;
+    unsigned int getThreadCount() const {return static_cast<unsigned int>(workers_.size());}
+
+  private:
+    struct Task {
+      SearchGenerator search;
+      StepCallback on_step;
+    };
+
+    void runWorker();
+
+    // Resumes task for one step, false once the search is over
+    static bool runStep(Task& task);
+
+    // Tells the callback how task ended and frees it
+    static void endTask(Task& task, SearchStatus status);
+
+    mutable std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable idle_;
+    std::deque<Task> tasks_;
+    unsigned long in_flight_;
+    unsigned long failed_count_;
+    bool stopping_;
+    std::vector<std::thread> workers_;
+};
+}
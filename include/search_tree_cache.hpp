@@ -0,0 +1,264 @@
+/**
+ * @file search_tree_cache.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief LRU cache of complete single-source search trees
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+#include "grid_search.hpp"
+#include "distance_field.hpp"
+
+// Bytes of parent arrays a SearchTreeCache keeps by default, about 200 trees
+// of the project map
+#define SEARCH_TREE_CACHE_BYTES (64UL << 20)
+
+namespace project2 {
+
+struct SearchTreeKey {
+  unsigned long start_index;
+  CostMode cost_mode;
+
+  // OccupancyGrid::getVersion of the map the tree was grown on
+  std::uint64_t map_version;
+
+  bool operator==(const SearchTreeKey& key) const
+  {
+    return start_index == key.start_index && cost_mode == key.cost_mode && map_version == key.map_version;
+  }
+};
+
+struct SearchTreeKeyHash {
+  std::size_t operator()(const SearchTreeKey& key) const
+  {
+    return project2::mixHash(key.map_version ^ (key.start_index << 1) ^ static_cast<std::uint64_t>(key.cost_mode));
+  }
+};
+
+struct SearchTreeCacheMetrics {
+  unsigned long hits {0};
+  unsigned long misses {0};
+  unsigned long evictions {0};
+  unsigned long tree_count {0};
+  unsigned long bytes {0};
+};
+
+/**
+ * @brief Answers planPath queries from complete shortest-path trees, one per
+ * (start cell, cost mode, map version). A miss runs Dijkstra from the start
+ * until the open list is empty and keeps the parent move of every cell, 4
+ * bits each, plus a bit per cell for whether the start reaches it. A hit,
+ * for any goal, is a backtrack over those arrays: no search at all. The cost
+ * is summed up along the path in the order planPath adds it, so both report
+ * the same value.
+ *
+ * The least recently used trees are evicted to stay within memory_budget
+ * bytes, a tree bigger than the whole budget is used once and not kept. A
+ * query with a clearance cost is keyed as CostMode::CLEARANCE, the distance
+ * field has to be the one of the current map with the same weights for every
+ * query. Not thread-safe.
+ *
+ */
+template <typename Neighborhood, typename Spec = GridSpec, typename Layout = RowMajorLayout<Spec>,
+  typename Cost = FloatCost>
+class SearchTreeCache
+{
+  public:
+    using Distance = typename Cost::value_type;
+
+    explicit SearchTreeCache(
+      const OccupancyGrid& occupancy_grid,
+      unsigned long memory_budget = SEARCH_TREE_CACHE_BYTES)
+    : occupancy_grid_ {occupancy_grid},
+      layout_ {occupancy_grid.getGridSpec()},
+      memory_budget_ {memory_budget},
+      workspace_ {},
+      cost_ {Cost::infinity}
+    {}
+
+    // Path from start to goal into getPath() and its cost into getCost()
+    SearchStatus planPath(const Position& start, const Position& goal, const DistanceField* clearance_cost = nullptr)
+    {
+      path_.clear();
+      cost_ = Cost::infinity;
+
+      if (!(layout_.spec == occupancy_grid_.getGridSpec()) || Layout::kind != occupancy_grid_.getLayout())
+        return SearchStatus::INVALID_GRID;
+
+      // An off-grid start would grow a tree from a cell that isn't there
+      if (!layout_.spec.contains(start) || !layout_.spec.contains(goal))
+        return SearchStatus::OUT_OF_BOUNDS;
+
+      const SearchTreeKey key {layout_.getIndex(start),
+        clearance_cost != nullptr ? CostMode::CLEARANCE : CostMode::PLAIN, occupancy_grid_.getVersion()};
+
+      const Tree* tree {findTree(key)};
+
+      if (tree != nullptr) {
+        metrics_.hits++;
+      }
+      else {
+        metrics_.misses++;
+        tree = &growTree(key, clearance_cost);
+      }
+
+      const auto status {backtrack(*tree, layout_.getIndex(goal), clearance_cost)};
+
+      // Too big to keep, grown into the spare slot
+      if (tree == &spare_)
+        spare_ = Tree {};
+
+      return status;
+    }
+
+    const std::vector<Position>& getPath() const {return path_;}
+    Distance getCost() const {return cost_;}
+
+    SearchTreeCacheMetrics getMetrics() const
+    {
+      auto metrics {metrics_};
+      metrics.tree_count = trees_.size();
+      metrics.bytes = bytes_;
+
+      return metrics;
+    }
+
+    void clear()
+    {
+      trees_.clear();
+      index_.clear();
+      bytes_ = 0;
+    }
+
+  private:
+    struct Tree {
+      SearchTreeKey key;
+
+      // Parent move of each cell, two cells per byte
+      std::vector<std::uint8_t> parents;
+
+      // Bit per cell, set if the start reaches it
+      std::vector<std::uint64_t> reached;
+
+      unsigned long getBytes() const {return parents.size() + reached.size() * sizeof(std::uint64_t);}
+
+      bool isReached(unsigned long index) const {return (reached[index >> 6] >> (index & 63)) & 1;}
+      unsigned int getParent(unsigned long index) const {return (parents[index >> 1] >> ((index & 1) * 4)) & 0x0F;}
+    };
+
+    // Moves a cached tree to the front of the LRU list
+    const Tree* findTree(const SearchTreeKey& key)
+    {
+      const auto found {index_.find(key)};
+
+      if (found == index_.end())
+        return nullptr;
+
+      trees_.splice(trees_.begin(), trees_, found->second);
+      return &trees_.front();
+    }
+
+    const Tree& growTree(const SearchTreeKey& key, const DistanceField* clearance_cost)
+    {
+      const auto start {layout_.getPosition(key.start_index)};
+
+      // The start is its own goal, settling on past FOUND until the open list runs dry
+      GridSearch<Neighborhood, Layout, Cost> search {start, start, occupancy_grid_, workspace_, clearance_cost,
+        limits_};
+      auto status {search.start()};
+
+      while (status == SearchStatus::RUNNING || status == SearchStatus::FOUND)
+        status = search.settleNext([](unsigned long) {});
+
+      const unsigned long cell_count {layout_.getStorageSize()};
+
+      Tree tree {key, std::vector<std::uint8_t>((cell_count + 1) / 2, 0),
+        std::vector<std::uint64_t>((cell_count + 63) / 64, 0)};
+
+      for (unsigned long index {0}; index < cell_count; index++) {
+        if (!workspace_.isClosed(index))
+          continue;
+
+        tree.reached[index >> 6] |= std::uint64_t {1} << (index & 63);
+        tree.parents[index >> 1] |= (workspace_.getParent(index) & NODE_PARENT_MASK) << ((index & 1) * 4);
+      }
+
+      if (tree.getBytes() > memory_budget_) {
+        spare_ = std::move(tree);
+        return spare_;
+      }
+
+      while (bytes_ + tree.getBytes() > memory_budget_) {
+        bytes_ -= trees_.back().getBytes();
+        index_.erase(trees_.back().key);
+        trees_.pop_back();
+        metrics_.evictions++;
+      }
+
+      bytes_ += tree.getBytes();
+      trees_.push_front(std::move(tree));
+      index_.emplace(key, trees_.begin());
+
+      return trees_.front();
+    }
+
+    SearchStatus backtrack(const Tree& tree, unsigned long goal_index, const DistanceField* clearance_cost)
+    {
+      if (!tree.isReached(goal_index))
+        return SearchStatus::NO_PATH;
+
+      moves_.clear();
+
+      for (auto index {goal_index}; index != tree.key.start_index; ) {
+        path_.push_back(layout_.getPosition(index));
+
+        const auto move {tree.getParent(index)};
+        moves_.push_back(static_cast<std::uint8_t>(move));
+        index = layout_.getNeighbor(index, layout_.getCellX(index), layout_.getCellY(index),
+          -Neighborhood::dx[move], -Neighborhood::dy[move]);
+      }
+
+      std::reverse(path_.begin(), path_.end());
+
+      // Same additions in the same order as the search
+      Distance cost {Cost::fromFloat(0.F)};
+      for (std::size_t i {0}; i < path_.size(); i++) {
+        cost = Cost::add(cost, Cost::fromFloat(Neighborhood::cost[moves_[moves_.size() - 1 - i]]));
+
+        if (clearance_cost != nullptr)
+          cost = Cost::add(cost, Cost::fromFloat(clearance_cost->getPenalty(layout_.getIndex(path_[i]))));
+      }
+
+      cost_ = cost;
+
+      return SearchStatus::FOUND;
+    }
+
+    const OccupancyGrid& occupancy_grid_;
+    const Layout layout_;
+    const unsigned long memory_budget_;
+    const SearchLimits limits_ {};
+
+    BasicPlannerWorkspace<Distance> workspace_;
+    std::list<Tree> trees_ {};
+    std::unordered_map<SearchTreeKey, typename std::list<Tree>::iterator, SearchTreeKeyHash> index_ {};
+    Tree spare_ {};
+    unsigned long bytes_ {0};
+    SearchTreeCacheMetrics metrics_ {};
+
+    std::vector<Position> path_ {};
+    std::vector<std::uint8_t> moves_ {};
+    Distance cost_;
+};
+
+}
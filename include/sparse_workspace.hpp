@@ -0,0 +1,90 @@
+/**
+ * @file sparse_workspace.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Declaration of the search buffers for unbounded or sparse maps
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include "project2.hpp"
+#include "flat_hash_map.hpp"
+
+namespace project2 {
+
+/**
+ * @brief Cell of the unbounded grid. Coordinates are signed 64 bit, so a
+ * search that steps left of or below the origin sees negative cells instead
+ * of wrapping around to the far end of the Position range.
+ *
+ */
+struct CellCoord {
+  long x {0};
+  long y {0};
+
+  bool operator==(const CellCoord& cell) const {return x == cell.x && y == cell.y;}
+  bool operator!=(const CellCoord& cell) const {return x != cell.x || y != cell.y;}
+};
+
+struct CellCoordHash {
+  unsigned long operator()(const CellCoord& cell) const
+  {
+    return mixHash(mixHash(static_cast<std::uint64_t>(cell.x)) ^ static_cast<std::uint64_t>(cell.y));
+  }
+};
+
+/**
+ * @brief PlannerWorkspace for maps where a dense per-cell array is not an
+ * option. Only the cells a query reaches get a node, numbered in the order
+ * they were reached; a flat hash map finds the node of a cell. The open
+ * list holds node numbers instead of cell indices.
+ *
+ */
+class SparsePlannerWorkspace
+{
+  public:
+    SparsePlannerWorkspace();
+
+    // Starts a new query, keeps the memory of the previous ones
+    void reset();
+
+    // Node of cell, added unvisited (infinite distance) if it has none
+    std::uint32_t getNode(const CellCoord& cell);
+
+    // Node of cell if the query reached it
+    const std::uint32_t* findNode(const CellCoord& cell) const {return node_ids_.find(cell);}
+
+    bool isClosed(std::uint32_t node) const {return parents_[node] & NODE_CLOSED;}
+    float getDistance(std::uint32_t node) const {return distances_[node];}
+    std::uint8_t getParent(std::uint32_t node) const {return parents_[node];}
+    const CellCoord& getCell(std::uint32_t node) const {return cells_[node];}
+
+    void setNode(std::uint32_t node, float distance, std::uint8_t parent)
+    {
+      distances_[node] = distance;
+      parents_[node] = parent;
+    }
+
+    void close(std::uint32_t node) {parents_[node] |= NODE_CLOSED;}
+
+    unsigned long size() const {return cells_.size();}
+
+    OpenList& getOpenList() {return open_list_;}
+    std::vector<CellCoord>& getPath() {return path_;}
+    const std::vector<CellCoord>& getPath() const {return path_;}
+
+  private:
+    FlatHashMap<CellCoord, std::uint32_t, CellCoordHash> node_ids_;
+    std::vector<CellCoord> cells_;
+    std::vector<float> distances_;
+    std::vector<std::uint8_t> parents_;
+    OpenList open_list_;
+    std::vector<CellCoord> path_;
+};
+}
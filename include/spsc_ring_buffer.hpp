@@ -0,0 +1,136 @@
+/**
+ * @file spsc_ring_buffer.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Lock-free single-producer single-consumer ring buffer
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+namespace project2 {
+
+/**
+ * @brief Bounded queue between exactly one producer and one consumer thread,
+ * used to hand the explored cells from the search thread to the renderer.
+ *
+ * Head and tail are free running counters on cache lines of their own, next
+ * to a copy of the other side's counter. Each side only reloads the other
+ * counter (acquire) when its copy says the ring is full or empty, and
+ * publishes its own with a release store, so the slots written before are
+ * visible to the other side. Neither side ever blocks: a push into a full
+ * ring fails and is counted as dropped.
+ *
+ */
+template <typename T>
+class SpscRingBuffer
+{
+  public:
+    // Capacity is rounded up to a power of two
+    explicit SpscRingBuffer(unsigned long capacity)
+    : slots_ (roundUpToPowerOfTwo(capacity)),
+      mask_ {slots_.size() - 1}
+    {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // Producer only
+    bool tryPush(const T& value)
+    {
+      const auto tail {producer_.tail.load(std::memory_order_relaxed)};
+
+      if (tail - producer_.cached_head == slots_.size()) {
+        producer_.cached_head = consumer_.head.load(std::memory_order_acquire);
+
+        if (tail - producer_.cached_head == slots_.size()) {
+          producer_.dropped.store(producer_.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+          return false;
+        }
+      }
+
+      // Copy constructed in place, some renderer types only declare a copy constructor
+      T* slot {&slots_[tail & mask_]};
+      std::destroy_at(slot);
+      ::new (static_cast<void*>(slot)) T(value);
+      producer_.tail.store(tail + 1, std::memory_order_release);
+
+      return true;
+    }
+
+    /**
+     * @brief Consumer only. Moves everything published so far, up to
+     * max_count values, to out with a single acquire and release.
+     *
+     * @return Number of values popped
+     */
+    template <typename OutputIt>
+    unsigned long popBatch(OutputIt out, unsigned long max_count = std::numeric_limits<unsigned long>::max())
+    {
+      const auto head {consumer_.head.load(std::memory_order_relaxed)};
+
+      if (consumer_.cached_tail - head < max_count)
+        consumer_.cached_tail = producer_.tail.load(std::memory_order_acquire);
+
+      const auto count {std::min(consumer_.cached_tail - head, max_count)};
+
+      for (unsigned long i {0}; i < count; i++)
+        *out++ = slots_[(head + i) & mask_];
+
+      consumer_.head.store(head + count, std::memory_order_release);
+
+      return count;
+    }
+
+    // Exact only while neither side is running
+    unsigned long size() const
+    {
+      return producer_.tail.load(std::memory_order_acquire) - consumer_.head.load(std::memory_order_acquire);
+    }
+
+    unsigned long capacity() const {return slots_.size();}
+    unsigned long getDroppedCount() const {return producer_.dropped.load(std::memory_order_relaxed);}
+
+  private:
+    static unsigned long roundUpToPowerOfTwo(unsigned long value)
+    {
+      unsigned long power {1};
+
+      while (power < value)
+        power <<= 1;
+
+      return power;
+    }
+
+    struct alignas(CACHE_LINE_SIZE) ProducerState {
+      std::atomic<unsigned long> tail {0};
+      unsigned long cached_head {0};
+      std::atomic<unsigned long> dropped {0};
+    };
+
+    struct alignas(CACHE_LINE_SIZE) ConsumerState {
+      std::atomic<unsigned long> head {0};
+      unsigned long cached_tail {0};
+    };
+
+    // Read only after construction, shared by both sides
+    std::vector<T> slots_;
+    unsigned long mask_;
+
+    ProducerState producer_;
+    ConsumerState consumer_;
+};
+}
@@ -0,0 +1,88 @@
+/**
+ * @file stepped_search.hpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Grid search as a coroutine that yields every few expansions
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "generator.hpp"
+#include "grid_search.hpp"
+
+// Expansions between two yields of the stepped search
+#define SEARCH_STEP_EXPANSIONS 4096
+
+namespace project2 {
+
+/**
+ * @brief What the stepped search hands back at each yield. settled holds the
+ * cells settled since the previous step and is only valid until the search
+ * is resumed. The last step carries the final status and the path is in the
+ * workspace by then.
+ *
+ */
+struct SearchStep {
+  SearchStatus status {SearchStatus::RUNNING};
+  std::span<const Position> settled {};
+  unsigned long expansions {0};
+};
+
+using SearchGenerator = Generator<SearchStep>;
+
+/**
+ * @brief planPath that gives control back to the caller after every
+ * step_expansions settled cells. Nothing runs between two steps, the caller
+ * decides when and on which thread to resume, and destroying the generator
+ * drops the search. The last step is never RUNNING, the path semantics are
+ * the ones of planPath, best partial path included.
+ *
+ * Arguments are taken by value and live in the coroutine frame. The occupancy
+ * grid, the workspace and the distance field have to outlive the generator,
+ * and the workspace can't be shared with another search in flight.
+ *
+ */
+template <typename Neighborhood, typename Spec = GridSpec, typename Layout = RowMajorLayout<Spec>,
+  typename Cost = FloatCost>
+SearchGenerator planPathSteps(
+  Position start,
+  Position goal,
+  const OccupancyGrid& occupancy_grid,
+  BasicPlannerWorkspace<typename Cost::value_type>& workspace,
+  unsigned long step_expansions = SEARCH_STEP_EXPANSIONS,
+  const DistanceField* clearance_cost = nullptr,
+  SearchLimits limits = SearchLimits {})
+{
+  if (step_expansions == 0)
+    step_expansions = 1;
+
+  GridSearch<Neighborhood, Layout, Cost> search {start, goal, occupancy_grid, workspace, clearance_cost, limits};
+  auto status {search.start()};
+
+  std::vector<Position> settled;
+  settled.reserve(status == SearchStatus::RUNNING ? step_expansions : 0);
+
+  unsigned long next_step {step_expansions};
+
+  while (status == SearchStatus::RUNNING) {
+    if (search.getExpansions() == next_step) {
+      co_yield SearchStep {SearchStatus::RUNNING, settled, search.getExpansions()};
+      settled.clear();
+      next_step += step_expansions;
+    }
+
+    status = search.settleNext([&](unsigned long index) {
+      settled.push_back(search.getLayout().getPosition(index));
+    });
+  }
+
+  search.finish(status);
+  co_yield SearchStep {status, settled, search.getExpansions()};
+}
+}
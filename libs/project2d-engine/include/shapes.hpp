@@ -116,6 +116,15 @@ void generatePolygonPoints(
   bool alt_orientation = false,
   bool closed_loop = true);
 
+void generateEllipsePoints(
+  std::vector<unsigned int>& points,
+  vec2ui center_point,
+  unsigned int radius_x,
+  unsigned int radius_y,
+  float angle = 0.F,
+  unsigned int segments = 32,
+  bool closed_loop = true);
+
 class PointsStatic
 {
   public:
@@ -44,6 +44,28 @@ void TwoDE::generatePolygonPoints(
   }
 }
 
+void TwoDE::generateEllipsePoints(
+  std::vector<unsigned int>& points,
+  TwoDE::vec2ui center_point,
+  unsigned int radius_x,
+  unsigned int radius_y,
+  float angle,
+  unsigned int segments,
+  bool closed_loop
+)
+{
+  unsigned int num_points {closed_loop ? segments + 1 : segments};
+
+  for (unsigned int i {0}; i < num_points; i++) {
+    double theta {(2 * M_PI * (i % segments)) / segments};
+    double x {radius_x * cos(theta)};
+    double y {radius_y * sin(theta)};
+
+    points.push_back(int(std::lround(center_point.x + x * cos(angle) - y * sin(angle))));
+    points.push_back(int(std::lround(center_point.y + x * sin(angle) + y * cos(angle))));
+  }
+}
+
 TwoDE::PointsStatic::PointsStatic(
   const std::vector<unsigned int>& points,
   const TwoDE::vec2ui& view_size,
@@ -0,0 +1,182 @@
+/**
+ * @file async_planner.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Implementation of the asynchronous planning facade on a thread pool
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <algorithm>
+
+#include "async_planner.hpp"
+
+namespace {
+
+// planPath with the layout of the grid picked at runtime
+project2::SearchStatus planOnGrid(
+  const project2::Position& start,
+  const project2::Position& goal,
+  const project2::OccupancyGrid& occupancy_grid,
+  project2::PlannerWorkspace& workspace,
+  const project2::DistanceField* clearance_cost,
+  const project2::SearchLimits& limits)
+{
+  using project2::GridSpec;
+  using project2::EightConnected;
+
+  switch (occupancy_grid.getLayout()) {
+    case project2::GridLayout::TILED:
+      return project2::planPath<EightConnected, GridSpec, project2::TiledLayout<GridSpec>>(
+        start, goal, occupancy_grid, workspace, clearance_cost, nullptr, limits);
+    case project2::GridLayout::PADDED:
+      return project2::planPath<EightConnected, GridSpec, project2::PaddedLayout<GridSpec>>(
+        start, goal, occupancy_grid, workspace, clearance_cost, nullptr, limits);
+    default:
+      return project2::planPath<EightConnected, GridSpec, project2::RowMajorLayout<GridSpec>>(
+        start, goal, occupancy_grid, workspace, clearance_cost, nullptr, limits);
+  }
+}
+
+}
+
+project2::AsyncPlanner::AsyncPlanner(
+  const project2::OccupancyGrid& occupancy_grid,
+  unsigned int thread_count)
+: occupancy_grid_ {occupancy_grid},
+  stopping_ {false}
+{
+  thread_count = std::max(thread_count, 1U);
+  workers_.reserve(thread_count);
+
+  for (unsigned int i {0}; i < thread_count; i++)
+    workers_.emplace_back(&AsyncPlanner::runWorker, this);
+}
+
+project2::AsyncPlanner::~AsyncPlanner()
+{
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    stopping_ = true;
+
+    for (auto& job: jobs_)
+      job.stop_token->store(true, std::memory_order_relaxed);
+  }
+
+  ready_.notify_all();
+
+  for (auto& worker: workers_)
+    worker.join();
+}
+
+project2::PlanHandle project2::AsyncPlanner::planAsync(
+  const project2::Position& start,
+  const project2::Position& goal,
+  const project2::PlanOptions& options,
+  Callback on_done)
+{
+  auto stop_token {std::make_shared<std::atomic<bool>>(false)};
+  std::promise<project2::PlanResult> promise {};
+  auto future {promise.get_future()};
+
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    jobs_.push_back({start, goal, options, project2::SearchLimits::Clock::now(), stop_token, std::move(promise),
+      std::move(on_done)});
+
+    metrics_.submitted++;
+    metrics_.queue_depth = jobs_.size();
+    metrics_.max_queue_depth = std::max(metrics_.max_queue_depth, metrics_.queue_depth);
+  }
+
+  ready_.notify_one();
+
+  return {std::move(stop_token), std::move(future)};
+}
+
+project2::PlannerMetrics project2::AsyncPlanner::getMetrics() const
+{
+  std::lock_guard<std::mutex> lock {mutex_};
+  return metrics_;
+}
+
+void project2::AsyncPlanner::runWorker()
+{
+  project2::PlannerWorkspace workspace {occupancy_grid_.size()};
+
+  while (true) {
+    std::unique_lock<std::mutex> lock {mutex_};
+    ready_.wait(lock, [this] {return stopping_ || !jobs_.empty();});
+
+    // Queued jobs are drained as cancelled before the worker leaves
+    if (jobs_.empty())
+      return;
+
+    auto job {std::move(jobs_.front())};
+    jobs_.pop_front();
+    metrics_.queue_depth = jobs_.size();
+    lock.unlock();
+
+    auto result {runJob(job, workspace)};
+
+    lock.lock();
+    metrics_.completed++;
+    metrics_.cancelled += result.status == project2::SearchStatus::CANCELLED;
+    metrics_.total_queue_time += result.queue_time;
+    metrics_.max_queue_time = std::max(metrics_.max_queue_time, result.queue_time);
+    metrics_.total_run_time += result.run_time;
+    metrics_.max_run_time = std::max(metrics_.max_run_time, result.run_time);
+    lock.unlock();
+
+    if (job.on_done) {
+      // A throwing callback must not take the worker down with it
+      try {
+        job.on_done(result);
+      }
+      catch (...) {
+      }
+    }
+
+    job.promise.set_value(std::move(result));
+  }
+}
+
+project2::PlanResult project2::AsyncPlanner::runJob(Job& job, project2::PlannerWorkspace& workspace) const
+{
+  using Clock = project2::SearchLimits::Clock;
+
+  project2::PlanResult result {};
+  const auto t_begin {Clock::now()};
+  result.queue_time = t_begin - job.submit_time;
+
+  if (job.stop_token->load(std::memory_order_relaxed)) {
+    result.status = project2::SearchStatus::CANCELLED;
+    return result;
+  }
+
+  project2::SearchLimits limits {job.stop_token.get()};
+  limits.max_expansions = job.options.max_expansions;
+
+  if (job.options.timeout != Clock::duration::max())
+    limits.deadline = job.submit_time + job.options.timeout;
+
+  try {
+    result.status = planOnGrid(job.start, job.goal, occupancy_grid_, workspace, job.options.clearance_cost, limits);
+
+    const auto& path {workspace.getPath()};
+    result.path.assign(path.begin(), path.end());
+
+    if (result.status == project2::SearchStatus::FOUND)
+      result.cost = workspace.getDistance(occupancy_grid_.getIndex(job.goal));
+  }
+  catch (...) {
+    result.status = project2::SearchStatus::FAILED;
+    result.path.clear();
+  }
+
+  result.run_time = Clock::now() - t_begin;
+
+  return result;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file distance_field.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Implementation of the obstacle distance field
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "occupancy_grid.hpp"
+#include "distance_field.hpp"
+
+namespace {
+
+constexpr double squared_distance_inf {1e20};
+
+// 1D squared Euclidean distance transform of a sampled function (lower
+// envelope of parabolas, Felzenszwalb & Huttenlocher). Squared distances of
+// long rows don't fit int or the mantissa of a float, everything is double.
+void distanceTransform1D(
+  const std::vector<double>& f,
+  std::vector<double>& d,
+  std::vector<long>& v,
+  std::vector<double>& z)
+{
+  const long n {static_cast<long>(f.size())};
+  long k {0};
+
+  auto square {[](long value) {return static_cast<double>(value) * static_cast<double>(value);}};
+
+  v[0] = 0;
+  z[0] = -squared_distance_inf;
+  z[1] = squared_distance_inf;
+
+  for (long q {1}; q < n; q++) {
+    double s {((f[q] + square(q)) - (f[v[k]] + square(v[k]))) / (2. * static_cast<double>(q - v[k]))};
+
+    while (s <= z[k]) {
+      k--;
+      s = ((f[q] + square(q)) - (f[v[k]] + square(v[k]))) / (2. * static_cast<double>(q - v[k]));
+    }
+
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = squared_distance_inf;
+  }
+
+  k = 0;
+  for (long q {0}; q < n; q++) {
+    while (z[k + 1] < static_cast<double>(q))
+      k++;
+
+    d[q] = square(q - v[k]) + f[v[k]];
+  }
+}
+
+}
+
+project2::DistanceField::DistanceField(
+  const project2::OccupancyGrid& occupancy_grid,
+  float penalty_weight,
+  float decay_distance)
+: grid_spec_ {occupancy_grid.getGridSpec()},
+  layout_ {occupancy_grid.getGridSpec(), occupancy_grid.getLayout()},
+  width_ {occupancy_grid.getWidth()},
+  height_ {occupancy_grid.getHeight()},
+  distance_ (occupancy_grid.size(), 0.F),
+  penalty_ (occupancy_grid.size(), penalty_weight)
+{
+  // The transform runs in row-major order, the results go to the grid layout
+  std::vector<double> squared_distance (static_cast<unsigned long>(width_) * height_, squared_distance_inf);
+
+  for (unsigned int y {0}; y < height_; y++) {
+    for (unsigned int x {0}; x < width_; x++) {
+      if (occupancy_grid.isBlocked(static_cast<long>(x), static_cast<long>(y)))
+        squared_distance[x + static_cast<unsigned long>(width_) * y] = 0.;
+    }
+  }
+
+  computeDistanceTransform(squared_distance);
+
+  for (unsigned int y {0}; y < height_; y++) {
+    for (unsigned int x {0}; x < width_; x++) {
+      const auto index {layout_.getIndex(static_cast<long>(x), static_cast<long>(y))};
+
+      distance_[index] = static_cast<float>(std::sqrt(squared_distance[x + static_cast<unsigned long>(width_) * y]) * grid_spec_.cell_size);
+
+      if (distance_[index] > 0.F)
+        penalty_[index] = penalty_weight * std::exp(-distance_[index] / decay_distance);
+    }
+  }
+}
+
+void project2::DistanceField::computeDistanceTransform(std::vector<double>& squared_distance) const
+{
+  const unsigned int max_dim {std::max(width_, height_)};
+
+  std::vector<double> f (max_dim);
+  std::vector<double> d (max_dim);
+  std::vector<long> v (max_dim);
+  std::vector<double> z (max_dim + 1);
+
+  f.resize(height_);
+  d.resize(height_);
+  for (unsigned int x {0}; x < width_; x++) {
+    for (unsigned int y {0}; y < height_; y++)
+      f[y] = squared_distance[x + static_cast<unsigned long>(width_) * y];
+
+    distanceTransform1D(f, d, v, z);
+
+    for (unsigned int y {0}; y < height_; y++)
+      squared_distance[x + static_cast<unsigned long>(width_) * y] = d[y];
+  }
+
+  f.resize(width_);
+  d.resize(width_);
+  for (unsigned int y {0}; y < height_; y++) {
+    std::copy(squared_distance.begin() + static_cast<unsigned long>(width_) * y, squared_distance.begin() + static_cast<unsigned long>(width_) * (y + 1), f.begin());
+
+    distanceTransform1D(f, d, v, z);
+
+    std::copy(d.begin(), d.end(), squared_distance.begin() + static_cast<unsigned long>(width_) * y);
+  }
+}
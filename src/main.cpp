@@ -12,13 +12,17 @@
 #include <glad/gl.h>
 #include <GLFW/glfw3.h>
 #include <thread>
+#include <memory>
+#include <atomic>
+#include <iterator>
 
 #include "project2.hpp"
 #include "shapes.hpp"
 
 int main()
 {
-  TwoDE::vec2ui window_size {1200, 500};
+  project2::GridSpec grid_spec {1200, 500};
+  TwoDE::vec2ui window_size {grid_spec.width, grid_spec.height};
 
   // Initialize obstacle space
   std::vector<unsigned int> obstacle1_points {100, 100, 175, 100, 175, 500, 100, 500};
@@ -26,24 +30,19 @@ int main()
   std::vector<unsigned int> obstacle3_points {};
   TwoDE::generatePolygonPoints(obstacle3_points, {650, 250}, 6, 150, true, false);
 
-  std::vector<unsigned int> obstacle4_1_points {900, 125, 900, 50, 1100, 50, 1100, 125};
-  std::vector<unsigned int> obstacle4_2_points {1020, 125, 1100, 125, 1100, 375, 1020, 375};
-  std::vector<unsigned int> obstacle4_3_points {1100, 375, 1100, 450, 900, 450, 900, 375};
+  std::vector<unsigned int> obstacle4_points {
+    900, 50, 1100, 50, 1100, 450, 900, 450, 900, 375, 1020, 375, 1020, 125, 900, 125};
 
-  project2::ObstacleSpace obstacle_space1 {obstacle1_points, 5, window_size};
-  project2::ObstacleSpace obstacle_space2 {obstacle2_points, 5, window_size};
-  project2::ObstacleSpace obstacle_space3 {obstacle3_points, 5, window_size};
-  project2::ObstacleSpace obstacle_space4_1 {obstacle4_1_points, 5, window_size};
-  project2::ObstacleSpace obstacle_space4_2 {obstacle4_2_points, 5, window_size};
-  project2::ObstacleSpace obstacle_space4_3 {obstacle4_3_points, 5, window_size};
+  auto obstacle_space1 {std::make_shared<project2::ObstacleSpace>(obstacle1_points, 5, grid_spec)};
+  auto obstacle_space2 {std::make_shared<project2::ObstacleSpace>(obstacle2_points, 5, grid_spec)};
+  auto obstacle_space3 {std::make_shared<project2::ObstacleSpace>(obstacle3_points, 5, grid_spec)};
+  auto obstacle_space4 {std::make_shared<project2::ObstacleSpace>(obstacle4_points, 5, grid_spec)};
 
-  std::vector<project2::ObstacleSpace> obstacles_space {
+  project2::ObstacleList obstacles_space {
     obstacle_space1,
     obstacle_space2,
     obstacle_space3,
-    obstacle_space4_1,
-    obstacle_space4_2,
-    obstacle_space4_3};
+    obstacle_space4};
 
   project2::Position start_node_pos {};
   project2::Position goal_node_pos {};
@@ -83,6 +82,26 @@ int main()
           || !(goal_node_pos.y > 0) || !(goal_node_pos.y < window_size.y)
           || in_obstacle_space);
 
+  int cost_mode_input {};
+
+  do {
+    std::cout << '\n' << "-- Select cost mode --" << '\n';
+    std::cout << "0: plain, 1: clearance-aware: ";
+    std::cin >> cost_mode_input;
+  } while (cost_mode_input != static_cast<int>(project2::CostMode::PLAIN)
+          && cost_mode_input != static_cast<int>(project2::CostMode::CLEARANCE));
+
+  auto cost_mode {static_cast<project2::CostMode>(cost_mode_input)};
+
+  // Rasterize the union of all obstacles once, the search only does lookups
+  project2::OccupancyGrid occupancy_grid {obstacles_space, grid_spec};
+
+  // Precompute the obstacle distance field for the clearance-aware cost
+  std::unique_ptr<project2::DistanceField> distance_field {};
+
+  if (cost_mode == project2::CostMode::CLEARANCE)
+    distance_field = std::make_unique<project2::DistanceField>(occupancy_grid);
+
   // Initialize GLFW window
   GLFWwindow* window;
 
@@ -127,9 +146,12 @@ int main()
   TwoDE::generatePolygonPoints(obstacle3_map_points, {650, 250}, 6, 150, true, true);
   TwoDE::PolygonSimpleStatic obstacle3 {obstacle3_map_points, window_size, {103, 146, 137}};
 
-  TwoDE::PolygonSimpleStatic obstacle4_1 {obstacle4_1_points, window_size, {103, 146, 137}};
-  TwoDE::PolygonSimpleStatic obstacle4_2 {obstacle4_2_points, window_size, {103, 146, 137}};
-  TwoDE::PolygonSimpleStatic obstacle4_3 {obstacle4_3_points, window_size, {103, 146, 137}};
+  // Triangle fans only draw convex polygons, use the decomposed pieces.
+  std::vector<std::unique_ptr<TwoDE::PolygonSimpleStatic>> obstacle4 {};
+  for (const auto& convex_polygon: obstacle_space4->getConvexPolygons()) {
+    obstacle4.push_back(std::make_unique<TwoDE::PolygonSimpleStatic>(
+      convex_polygon, window_size, TwoDE::color4ui {103, 146, 137}));
+  }
 
   // Initialize OpenGL shader and set some parameters for rendering
   auto gl_program {project2::initShader()};
@@ -146,22 +168,27 @@ int main()
   auto start_node {project2::Node(start_node_pos)};
   auto goal_node {project2::Node(goal_node_pos)};
 
-  std::deque<TwoDE::vec2ui> explored_nodes {};
+  // Every cell is explored at most once, so a ring of one slot per cell
+  // never makes the search drop a node
+  project2::SpscRingBuffer<TwoDE::vec2ui> explored_nodes {occupancy_grid.size()};
+  std::deque<TwoDE::vec2ui> rendered_nodes {};
   std::deque<TwoDE::vec2ui> backtracked_path {};
   TwoDE::color4ui node_color {103, 146, 137, 25};
 
   // Start Dijkstra search on a dedicated thread and update the buffer with
   // explored nodes.
-  bool continue_search {true};
-  bool search_complete {false};
+  std::atomic<bool> stop_search {false};
+  project2::SearchLimits search_limits {&stop_search};
+  std::atomic<bool> search_complete {false};
   std::thread search_thread {project2::searchDijkstra,
     std::ref(start_node),
     std::ref(goal_node),
-    std::ref(obstacles_space),
+    std::cref(occupancy_grid),
     std::ref(explored_nodes),
     std::ref(backtracked_path),
-    std::ref(continue_search),
-    std::ref(search_complete)};
+    std::cref(search_limits),
+    std::ref(search_complete),
+    distance_field.get()};
 
   // Render for visualization
   while(!glfwWindowShouldClose(window)) {
@@ -170,13 +197,17 @@ int main()
     glClear(GL_COLOR_BUFFER_BIT);
     glClearColor(0.075, 0.075, 0.075, 1.0);
 
-    // Update the GPU vertex buffer with explored nodes and render.
-    if (search_complete) {
+    // Update the GPU vertex buffer with explored nodes and render. Once the
+    // search is over the path is drawn, the partial one if it stopped early.
+    if (search_complete.load(std::memory_order_acquire)) {
       node_color = {244, 201, 93};
-      map_graph.setPointsColor(backtracked_path, node_color, backtracked_path.size() - 1);
+
+      if (!backtracked_path.empty())
+        map_graph.setPointsColor(backtracked_path, node_color, backtracked_path.size() - 1);
     }
     else {
-      map_graph.setPointsColor(explored_nodes, node_color, explored_nodes.size() - 1);
+      explored_nodes.popBatch(std::back_inserter(rendered_nodes));
+      map_graph.setPointsColor(rendered_nodes, node_color, rendered_nodes.size() - 1);
     }
 
     map_graph.bind();
@@ -194,18 +225,16 @@ int main()
     obstacle3.bind();
     glDrawElements(GL_TRIANGLE_FAN, obstacle3.size(), GL_UNSIGNED_INT, nullptr);
 
-    obstacle4_1.bind();
-    glDrawElements(GL_TRIANGLE_FAN, obstacle4_1.size(), GL_UNSIGNED_INT, nullptr);
-    obstacle4_2.bind();
-    glDrawElements(GL_TRIANGLE_FAN, obstacle4_2.size(), GL_UNSIGNED_INT, nullptr);
-    obstacle4_3.bind();
-    glDrawElements(GL_TRIANGLE_FAN, obstacle4_3.size(), GL_UNSIGNED_INT, nullptr);
+    for (auto& obstacle4_piece: obstacle4) {
+      obstacle4_piece->bind();
+      glDrawElements(GL_TRIANGLE_FAN, obstacle4_piece->size(), GL_UNSIGNED_INT, nullptr);
+    }
 
     glfwSwapBuffers(window);
   }
 
   // Wrap-up
-  continue_search = false;
+  stop_search.store(true, std::memory_order_relaxed);
 
   search_thread.join();
 
@@ -0,0 +1,590 @@
+/**
+ * @file occupancy_grid.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Implementation of the rasterized obstacle space
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <thread>
+
+#include "project2.hpp"
+#include "occupancy_grid.hpp"
+
+namespace {
+
+// Neighbor mask bits of the moves to cells that are labeled before the
+// current one in row order: left and the three cells of the row below.
+constexpr unsigned int down_right_bit {1U << 3};
+constexpr unsigned int down_bit {1U << 4};
+constexpr unsigned int down_left_bit {1U << 5};
+constexpr unsigned int left_bit {1U << 6};
+
+std::uint32_t findRoot(std::vector<std::uint32_t>& parents, std::uint32_t index)
+{
+  // Path halving
+  while (parents[index] != index) {
+    parents[index] = parents[parents[index]];
+    index = parents[index];
+  }
+
+  return index;
+}
+
+// The smaller index becomes the root, so the labels don't depend on the
+// order the unions happen in
+void unite(std::vector<std::uint32_t>& parents, std::uint32_t a, std::uint32_t b)
+{
+  a = findRoot(parents, a);
+  b = findRoot(parents, b);
+
+  if (a < b)
+    parents[b] = a;
+  else if (b < a)
+    parents[a] = b;
+}
+
+// Runs work(first_row, last_row) on consecutive strips of rows, one thread
+// per strip
+template <typename Work>
+void forEachStrip(unsigned int rows, unsigned int strip_count, Work&& work)
+{
+  std::vector<std::thread> threads {};
+
+  for (unsigned int strip {1}; strip < strip_count; strip++)
+    threads.emplace_back(work, rows * strip / strip_count, rows * (strip + 1) / strip_count);
+
+  work(0U, rows / strip_count);
+
+  for (auto& thread: threads)
+    thread.join();
+}
+
+// Labels with the top bit set mark cells claimed by a search of a split,
+// the low bits are the search
+constexpr std::uint32_t claimed_bit {1U << 31};
+
+// Share of a blocked cell in the grid version, blocking or freeing the cell
+// toggles it
+std::uint64_t getCellHash(unsigned long index)
+{
+  return project2::mixHash(index + 1);
+}
+
+}
+
+project2::OccupancyGrid::OccupancyGrid(
+  const project2::ObstacleList& obstacles,
+  const project2::GridSpec& grid_spec,
+  project2::GridLayout layout)
+: grid_spec_ {grid_spec},
+  layout_ {grid_spec, layout},
+  width_ {grid_spec.getColumns()},
+  height_ {grid_spec.getRows()},
+  blocked_ (layout_.getStorageSize(), 1),
+  neighbor_masks_ (blocked_.size(), 0),
+  components_ (blocked_.size(), 0),
+  component_count_ {0},
+  version_ {project2::mixHash((static_cast<std::uint64_t>(grid_spec.width) << 40)
+    ^ (static_cast<std::uint64_t>(grid_spec.height) << 16) ^ (grid_spec.cell_size << 2)
+    ^ static_cast<std::uint64_t>(layout))}
+{
+  // Padding cells of partial tiles stay blocked
+  for (unsigned int y {0}; y < height_; y++) {
+    for (unsigned int x {0}; x < width_; x++) {
+      project2::Position position {x * grid_spec_.cell_size, y * grid_spec_.cell_size};
+
+      blocked_[getIndex(x, y)] = project2::inObstacleSpace(position, obstacles);
+    }
+  }
+
+  for (unsigned long index {0}; index < blocked_.size(); index++) {
+    if (blocked_[index])
+      version_ ^= getCellHash(index);
+  }
+
+  computeNeighborMasks();
+  computeComponents();
+}
+
+void project2::OccupancyGrid::computeNeighborMasks()
+{
+  for (unsigned int y {0}; y < height_; y++) {
+    for (unsigned int x {0}; x < width_; x++)
+      neighbor_masks_[getIndex(x, y)] = computeNeighborMask(x, y);
+  }
+}
+
+unsigned char project2::OccupancyGrid::computeNeighborMask(long cell_x, long cell_y) const
+{
+  if (blocked_[getIndex(cell_x, cell_y)])
+    return 0;
+
+  unsigned char neighbor_mask {0};
+
+  for (unsigned int i {0}; i < project2::actions_list.size(); i++) {
+    if (!isBlocked(cell_x + project2::action_dx[i], cell_y + project2::action_dy[i]))
+      neighbor_mask |= 1 << i;
+  }
+
+  return neighbor_mask;
+}
+
+void project2::OccupancyGrid::computeComponents()
+{
+  // Strips of at least 64 rows, one per hardware thread
+  const unsigned int strip_count {std::max(1U,
+    std::min(std::thread::hardware_concurrency(), height_ / 64))};
+
+  std::vector<std::uint32_t> parents (blocked_.size());
+
+  auto uniteNeighbors {[&](unsigned int x, unsigned int y, unsigned int neighbor_mask) {
+    const auto index {static_cast<std::uint32_t>(getIndex(x, y))};
+
+    if (neighbor_mask & left_bit)
+      unite(parents, index, static_cast<std::uint32_t>(getIndex(x - 1, y)));
+    if (neighbor_mask & down_left_bit)
+      unite(parents, index, static_cast<std::uint32_t>(getIndex(x - 1, y - 1)));
+    if (neighbor_mask & down_bit)
+      unite(parents, index, static_cast<std::uint32_t>(getIndex(x, y - 1)));
+    if (neighbor_mask & down_right_bit)
+      unite(parents, index, static_cast<std::uint32_t>(getIndex(x + 1, y - 1)));
+  }};
+
+  // Every strip only links cells of its own rows, the trees stay disjoint
+  forEachStrip(height_, strip_count, [&](unsigned int first_row, unsigned int last_row) {
+    for (unsigned int y {first_row}; y < last_row; y++) {
+      for (unsigned int x {0}; x < width_; x++) {
+        const auto index {getIndex(x, y)};
+        parents[index] = static_cast<std::uint32_t>(index);
+      }
+    }
+
+    for (unsigned int y {first_row}; y < last_row; y++) {
+      for (unsigned int x {0}; x < width_; x++) {
+        const auto index {getIndex(x, y)};
+
+        if (blocked_[index])
+          continue;
+
+        const unsigned int below_mask {y > first_row ? down_left_bit | down_bit | down_right_bit : 0U};
+        uniteNeighbors(x, y, neighbor_masks_[index] & (left_bit | below_mask));
+      }
+    }
+  });
+
+  // Stitch the strips together along their first rows
+  for (unsigned int strip {1}; strip < strip_count; strip++) {
+    const unsigned int y {height_ * strip / strip_count};
+
+    for (unsigned int x {0}; x < width_; x++) {
+      const auto index {getIndex(x, y)};
+
+      if (!blocked_[index])
+        uniteNeighbors(x, y, neighbor_masks_[index] & (down_left_bit | down_bit | down_right_bit));
+    }
+  }
+
+  // Roots are read only from here on, so the lookups can run in parallel
+  forEachStrip(height_, strip_count, [&](unsigned int first_row, unsigned int last_row) {
+    for (unsigned int y {first_row}; y < last_row; y++) {
+      for (unsigned int x {0}; x < width_; x++) {
+        const auto index {getIndex(x, y)};
+        auto root {static_cast<std::uint32_t>(index)};
+
+        while (parents[root] != root)
+          root = parents[root];
+
+        components_[index] = root;
+      }
+    }
+  });
+
+  // Dense IDs in the order of the roots, kept in the parent slots of the
+  // roots which are not needed anymore
+  component_count_ = 0;
+
+  for (unsigned int y {0}; y < height_; y++) {
+    for (unsigned int x {0}; x < width_; x++) {
+      const auto index {getIndex(x, y)};
+
+      if (!blocked_[index] && components_[index] == index)
+        parents[index] = ++component_count_;
+    }
+  }
+
+  forEachStrip(height_, strip_count, [&](unsigned int first_row, unsigned int last_row) {
+    for (unsigned int y {first_row}; y < last_row; y++) {
+      for (unsigned int x {0}; x < width_; x++) {
+        const auto index {getIndex(x, y)};
+        components_[index] = blocked_[index] ? 0 : parents[components_[index]];
+      }
+    }
+  });
+
+  component_sizes_.assign(component_count_ + 1, 0);
+  free_components_.clear();
+
+  for (const auto component: components_) {
+    if (component != 0)
+      component_sizes_[component]++;
+  }
+}
+
+template <typename Test>
+std::vector<unsigned long> project2::OccupancyGrid::findCells(
+  const project2::Bounds& bounds,
+  Test&& test) const
+{
+  const auto cell_size {static_cast<float>(grid_spec_.cell_size)};
+  const auto max_x {static_cast<float>(width_ - 1)};
+  const auto max_y {static_cast<float>(height_ - 1)};
+
+  const auto first_x {static_cast<long>(std::clamp(std::floor(bounds.x_min / cell_size), 0.F, max_x))};
+  const auto first_y {static_cast<long>(std::clamp(std::floor(bounds.y_min / cell_size), 0.F, max_y))};
+  const auto last_x {static_cast<long>(std::clamp(std::ceil(bounds.x_max / cell_size), 0.F, max_x))};
+  const auto last_y {static_cast<long>(std::clamp(std::ceil(bounds.y_max / cell_size), 0.F, max_y))};
+
+  std::vector<unsigned long> cells {};
+
+  for (long y {first_y}; y <= last_y; y++) {
+    for (long x {first_x}; x <= last_x; x++) {
+      const auto index {getIndex(x, y)};
+      const project2::Position position {static_cast<unsigned int>(x) * grid_spec_.cell_size,
+                                         static_cast<unsigned int>(y) * grid_spec_.cell_size};
+
+      if (test(index, position))
+        cells.push_back(index);
+    }
+  }
+
+  return cells;
+}
+
+template <typename Test>
+std::vector<unsigned long> project2::OccupancyGrid::findObstacleCells(
+  const project2::Obstacle& obstacle,
+  Test&& test) const
+{
+  auto cells {findCells(obstacle.getBounds(), test)};
+
+  // The band is only blocked while some obstacle is on the map
+  for (const auto& bounds: obstacle.getBoundaryBounds()) {
+    const auto band_cells {findCells(bounds, test)};
+    cells.insert(cells.end(), band_cells.begin(), band_cells.end());
+  }
+
+  std::sort(cells.begin(), cells.end());
+  cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+  return cells;
+}
+
+void project2::OccupancyGrid::addObstacle(const project2::Obstacle& obstacle)
+{
+  blockCells(findObstacleCells(obstacle, [&](unsigned long index, const project2::Position& position) {
+    return !blocked_[index] && obstacle.containsPoint(position);
+  }));
+}
+
+void project2::OccupancyGrid::removeObstacle(
+  const project2::Obstacle& obstacle,
+  const project2::ObstacleList& remaining_obstacles)
+{
+  freeCells(findObstacleCells(obstacle, [&](unsigned long index, const project2::Position& position) {
+    return blocked_[index] && obstacle.containsPoint(position)
+      && !project2::inObstacleSpace(position, remaining_obstacles);
+  }));
+}
+
+void project2::OccupancyGrid::blockCells(const std::vector<unsigned long>& cells)
+{
+  for (const auto index: cells) {
+    const auto component {components_[index]};
+
+    blocked_[index] = 1;
+    components_[index] = 0;
+    version_ ^= getCellHash(index);
+
+    if (--component_sizes_[component] == 0)
+      releaseComponent(component);
+  }
+
+  updateNeighborMasks(cells);
+
+  // Free cells around the new obstacle by component. A component touched by
+  // a single cell can't have been split.
+  std::vector<std::pair<std::uint32_t, unsigned long>> seeds {};
+
+  for (const auto index: cells) {
+    const auto cell_x {layout_.getCellX(index)};
+    const auto cell_y {layout_.getCellY(index)};
+
+    for (unsigned int i {0}; i < project2::actions_list.size(); i++) {
+      const long neighbor_x {cell_x + project2::action_dx[i]};
+      const long neighbor_y {cell_y + project2::action_dy[i]};
+
+      if (isBlocked(neighbor_x, neighbor_y))
+        continue;
+
+      const auto neighbor {getIndex(neighbor_x, neighbor_y)};
+      seeds.emplace_back(components_[neighbor], neighbor);
+    }
+  }
+
+  std::sort(seeds.begin(), seeds.end());
+  seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+
+  std::vector<unsigned long> component_seeds {};
+
+  for (auto first {seeds.begin()}; first != seeds.end(); ) {
+    auto last {std::find_if(first, seeds.end(), [&](const auto& seed) {return seed.first != first->first;})};
+
+    if (last - first > 1) {
+      component_seeds.clear();
+
+      for (auto seed {first}; seed != last; seed++)
+        component_seeds.push_back(seed->second);
+
+      splitComponent(component_seeds);
+    }
+
+    first = last;
+  }
+}
+
+void project2::OccupancyGrid::splitComponent(const std::vector<unsigned long>& seeds)
+{
+  const auto component {components_[seeds.front()]};
+  const auto search_count {static_cast<std::uint32_t>(seeds.size())};
+
+  // One breadth-first search per seed, every cell is claimed by the search
+  // that reached it first. Searches that meet are grouped, they are on the
+  // same piece.
+  std::vector<std::vector<unsigned long>> visited (search_count);
+  std::vector<unsigned long> heads (search_count, 0);
+  std::vector<std::uint32_t> groups (search_count);
+  std::vector<std::uint32_t> active_searches (search_count, 1);
+
+  for (std::uint32_t search {0}; search < search_count; search++) {
+    visited[search].push_back(seeds[search]);
+    groups[search] = search;
+    components_[seeds[search]] = claimed_bit | search;
+  }
+
+  // Round robin, one cell per search and turn, until one group is left. It
+  // keeps the old ID, every group that ran out of cells before is a piece
+  // that split off. The work is bounded by the pieces that split off rather
+  // than by the whole component.
+  unsigned long active_groups {search_count};
+  std::vector<unsigned char> finished (search_count, 0);
+  std::vector<std::uint32_t> turns (search_count);
+
+  std::iota(turns.begin(), turns.end(), 0U);
+
+  while (active_groups > 1) {
+    for (unsigned long turn {0}; turn < turns.size() && active_groups > 1; ) {
+      const auto search {turns[turn]};
+      const auto index {visited[search][heads[search]++]};
+      const auto neighbor_mask {neighbor_masks_[index]};
+
+      for (unsigned int i {0}; i < project2::actions_list.size(); i++) {
+        if (!(neighbor_mask & (1U << i)))
+          continue;
+
+        const auto neighbor {getNeighbor(index, i)};
+
+        if (components_[neighbor] == component) {
+          components_[neighbor] = claimed_bit | search;
+          visited[search].push_back(neighbor);
+          continue;
+        }
+
+        const auto root {findRoot(groups, search)};
+        const auto other_root {findRoot(groups, components_[neighbor] & ~claimed_bit)};
+
+        if (root == other_root)
+          continue;
+
+        unite(groups, root, other_root);
+        active_searches[findRoot(groups, root)] = active_searches[root] + active_searches[other_root];
+        active_groups--;
+      }
+
+      if (heads[search] < visited[search].size()) {
+        turn++;
+        continue;
+      }
+
+      // Out of cells, drop it from the turns
+      turns[turn] = turns.back();
+      turns.pop_back();
+
+      if (--active_searches[findRoot(groups, search)] == 0) {
+        finished[findRoot(groups, search)] = 1;
+        active_groups--;
+      }
+    }
+  }
+
+  // Finished groups get new IDs, the claims of the last group are undone
+  std::vector<std::uint32_t> pieces (search_count, component);
+
+  for (std::uint32_t search {0}; search < search_count; search++) {
+    const auto root {findRoot(groups, search)};
+
+    if (finished[root] && pieces[root] == component)
+      pieces[root] = allocateComponent();
+
+    for (const auto index: visited[search])
+      components_[index] = pieces[root];
+
+    if (pieces[root] != component) {
+      component_sizes_[pieces[root]] += static_cast<std::uint32_t>(visited[search].size());
+      component_sizes_[component] -= static_cast<std::uint32_t>(visited[search].size());
+    }
+  }
+}
+
+void project2::OccupancyGrid::freeCells(const std::vector<unsigned long>& cells)
+{
+  for (const auto index: cells) {
+    blocked_[index] = 0;
+    version_ ^= getCellHash(index);
+  }
+
+  updateNeighborMasks(cells);
+
+  // Freed cells are the only free ones without a label. Every cluster of
+  // them gets a new component, then the cluster and the components it
+  // touches are flooded into the largest one of them.
+  std::vector<unsigned long> cluster {};
+  std::vector<std::pair<std::uint32_t, unsigned long>> touched {};
+
+  for (const auto seed: cells) {
+    if (components_[seed] != 0)
+      continue;
+
+    const auto component {allocateComponent()};
+
+    components_[seed] = component;
+    cluster.assign(1, seed);
+    touched.clear();
+
+    for (unsigned long head {0}; head < cluster.size(); head++) {
+      const auto index {cluster[head]};
+      const auto neighbor_mask {neighbor_masks_[index]};
+
+      for (unsigned int i {0}; i < project2::actions_list.size(); i++) {
+        if (!(neighbor_mask & (1U << i)))
+          continue;
+
+        const auto neighbor {getNeighbor(index, i)};
+        const auto neighbor_component {components_[neighbor]};
+
+        if (neighbor_component == 0) {
+          components_[neighbor] = component;
+          cluster.push_back(neighbor);
+        }
+        else if (neighbor_component != component
+          && std::find_if(touched.begin(), touched.end(),
+               [&](const auto& other) {return other.first == neighbor_component;}) == touched.end())
+          touched.emplace_back(neighbor_component, neighbor);
+      }
+    }
+
+    component_sizes_[component] = static_cast<std::uint32_t>(cluster.size());
+
+    auto target {component};
+
+    for (const auto& other: touched) {
+      if (component_sizes_[other.first] > component_sizes_[target])
+        target = other.first;
+    }
+
+    if (target != component)
+      relabelComponent(seed, target);
+
+    for (const auto& other: touched) {
+      if (other.first != target)
+        relabelComponent(other.second, target);
+    }
+  }
+}
+
+void project2::OccupancyGrid::updateNeighborMasks(const std::vector<unsigned long>& cells)
+{
+  for (const auto index: cells) {
+    const auto cell_x {layout_.getCellX(index)};
+    const auto cell_y {layout_.getCellY(index)};
+
+    neighbor_masks_[index] = computeNeighborMask(cell_x, cell_y);
+
+    for (unsigned int i {0}; i < project2::actions_list.size(); i++) {
+      const long neighbor_x {cell_x + project2::action_dx[i]};
+      const long neighbor_y {cell_y + project2::action_dy[i]};
+
+      if (neighbor_x >= 0 && neighbor_x < width_ && neighbor_y >= 0 && neighbor_y < height_)
+        neighbor_masks_[getIndex(neighbor_x, neighbor_y)] = computeNeighborMask(neighbor_x, neighbor_y);
+    }
+  }
+}
+
+// Floods the component of seed with another ID
+void project2::OccupancyGrid::relabelComponent(unsigned long seed, std::uint32_t component)
+{
+  const auto old_component {components_[seed]};
+  std::vector<unsigned long> queue {seed};
+
+  components_[seed] = component;
+
+  for (unsigned long head {0}; head < queue.size(); head++) {
+    const auto index {queue[head]};
+    const auto neighbor_mask {neighbor_masks_[index]};
+
+    for (unsigned int i {0}; i < project2::actions_list.size(); i++) {
+      if (!(neighbor_mask & (1U << i)))
+        continue;
+
+      const auto neighbor {getNeighbor(index, i)};
+
+      if (components_[neighbor] == old_component) {
+        components_[neighbor] = component;
+        queue.push_back(neighbor);
+      }
+    }
+  }
+
+  component_sizes_[component] += component_sizes_[old_component];
+  releaseComponent(old_component);
+}
+
+std::uint32_t project2::OccupancyGrid::allocateComponent()
+{
+  component_count_++;
+
+  if (free_components_.empty()) {
+    component_sizes_.push_back(0);
+
+    return static_cast<std::uint32_t>(component_sizes_.size() - 1);
+  }
+
+  const auto component {free_components_.back()};
+  free_components_.pop_back();
+  component_sizes_[component] = 0;
+
+  return component;
+}
+
+void project2::OccupancyGrid::releaseComponent(std::uint32_t component)
+{
+  component_sizes_[component] = 0;
+  free_components_.push_back(component);
+  component_count_--;
+}
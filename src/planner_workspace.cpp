@@ -0,0 +1,58 @@
+/**
+ * @file planner_workspace.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Implementation of the reusable per-query search buffers
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <algorithm>
+
+#include "planner_workspace.hpp"
+
+template <typename Distance>
+project2::BasicPlannerWorkspace<Distance>::BasicPlannerWorkspace(std::pmr::memory_resource* resource)
+: generation_ {0},
+  generations_ (resource),
+  distances_ (resource),
+  parents_ (resource),
+  open_list_ {resource},
+  path_ (resource)
+{}
+
+template <typename Distance>
+project2::BasicPlannerWorkspace<Distance>::BasicPlannerWorkspace(
+  unsigned long cell_count,
+  std::pmr::memory_resource* resource)
+: project2::BasicPlannerWorkspace<Distance>(resource)
+{
+  reset(cell_count);
+}
+
+template <typename Distance>
+void project2::BasicPlannerWorkspace<Distance>::reset(unsigned long cell_count)
+{
+  if (cell_count > generations_.size()) {
+    generations_.assign(cell_count, 0);
+    distances_.resize(cell_count);
+    parents_.resize(cell_count);
+    generation_ = 0;
+  }
+
+  generation_++;
+
+  // Wrapped around, stamps from 2^32 queries ago would look current
+  if (generation_ == 0) {
+    std::fill(generations_.begin(), generations_.end(), 0);
+    generation_ = 1;
+  }
+
+  open_list_.clear();
+  path_.clear();
+}
+
+template class project2::BasicPlannerWorkspace<float>;
+template class project2::BasicPlannerWorkspace<std::uint32_t>;
@@ -0,0 +1,345 @@
+/**
+ * @file polygon_decomposition.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Implementation of the convex decomposition of simple polygons
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+#include "polygon_decomposition.hpp"
+
+namespace {
+
+struct Vertex {
+  long long x;
+  long long y;
+};
+
+std::vector<Vertex> toVertices(const project2::PolygonPoints& points)
+{
+  std::vector<Vertex> vertices {};
+
+  for (auto i {points.begin()}; i + 1 < points.end(); i += 2)
+    vertices.push_back({static_cast<long long>(*i), static_cast<long long>(*(i + 1))});
+
+  return vertices;
+}
+
+// Positive when a -> b -> c turns left (counter-clockwise)
+long long cross(const Vertex& a, const Vertex& b, const Vertex& c)
+{
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+bool inTriangle(const Vertex& p, const Vertex& a, const Vertex& b, const Vertex& c)
+{
+  return cross(a, b, p) >= 0 && cross(b, c, p) >= 0 && cross(c, a, p) >= 0;
+}
+
+bool isConvexLoop(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& loop)
+{
+  const auto n {loop.size()};
+
+  for (unsigned long i {0}; i < n; i++) {
+    if (cross(vertices[loop[i]], vertices[loop[(i + 1) % n]], vertices[loop[(i + 2) % n]]) < 0)
+      return false;
+  }
+
+  return true;
+}
+
+}
+
+bool project2::isConvexPolygon(const project2::PolygonPoints& points)
+{
+  auto vertices {toVertices(points)};
+  std::vector<unsigned int> loop (vertices.size());
+
+  for (unsigned int i {0}; i < loop.size(); i++)
+    loop[i] = i;
+
+  return isConvexLoop(vertices, loop);
+}
+
+project2::PolygonPoints project2::normalizePolygon(const project2::PolygonPoints& points)
+{
+  auto vertices {toVertices(points)};
+
+  // Closing point and consecutive duplicates
+  std::vector<Vertex> unique_vertices {};
+  for (const auto& vertex: vertices) {
+    if (!unique_vertices.empty()
+      && unique_vertices.back().x == vertex.x && unique_vertices.back().y == vertex.y)
+      continue;
+
+    unique_vertices.push_back(vertex);
+  }
+
+  while (unique_vertices.size() > 1
+    && unique_vertices.front().x == unique_vertices.back().x
+    && unique_vertices.front().y == unique_vertices.back().y)
+    unique_vertices.pop_back();
+
+  // Collinear vertices only add redundant half-plane tests
+  bool removed {true};
+  while (removed && unique_vertices.size() > 3) {
+    removed = false;
+
+    for (unsigned long i {0}; i < unique_vertices.size(); i++) {
+      const auto n {unique_vertices.size()};
+      if (cross(unique_vertices[(i + n - 1) % n], unique_vertices[i], unique_vertices[(i + 1) % n]) == 0) {
+        unique_vertices.erase(unique_vertices.begin() + i);
+        removed = true;
+        break;
+      }
+    }
+  }
+
+  long long area {0};
+  for (unsigned long i {0}; i < unique_vertices.size(); i++) {
+    const auto& v1 {unique_vertices[i]};
+    const auto& v2 {unique_vertices[(i + 1) % unique_vertices.size()]};
+    area += v1.x * v2.y - v2.x * v1.y;
+  }
+
+  if (area < 0)
+    std::reverse(unique_vertices.begin(), unique_vertices.end());
+
+  project2::PolygonPoints normalized {};
+  for (const auto& vertex: unique_vertices) {
+    normalized.push_back(static_cast<unsigned int>(vertex.x));
+    normalized.push_back(static_cast<unsigned int>(vertex.y));
+  }
+
+  return normalized;
+}
+
+std::vector<std::vector<unsigned int>> project2::triangulatePolygon(
+  const project2::PolygonPoints& points)
+{
+  auto vertices {toVertices(points)};
+  std::vector<std::vector<unsigned int>> triangles {};
+
+  const auto n {static_cast<unsigned int>(vertices.size())};
+
+  if (n < 3)
+    return triangles;
+
+  // Remaining vertices as a circular linked list
+  std::vector<unsigned int> prev (n);
+  std::vector<unsigned int> next (n);
+  for (unsigned int i {0}; i < n; i++) {
+    prev[i] = (i + n - 1) % n;
+    next[i] = (i + 1) % n;
+  }
+
+  auto isConvex {[&](unsigned int i) {
+    return cross(vertices[prev[i]], vertices[i], vertices[next[i]]) > 0;
+  }};
+
+  // Only reflex vertices can lie inside an ear, they are the only ones tested.
+  // A vertex never turns reflex again once clipping made it convex.
+  std::vector<unsigned int> reflex {};
+  std::vector<unsigned int> reflex_slot (n, n);
+  for (unsigned int i {0}; i < n; i++) {
+    if (!isConvex(i)) {
+      reflex_slot[i] = static_cast<unsigned int>(reflex.size());
+      reflex.push_back(i);
+    }
+  }
+
+  auto removeReflex {[&](unsigned int i) {
+    if (reflex_slot[i] == n)
+      return;
+
+    reflex[reflex_slot[i]] = reflex.back();
+    reflex_slot[reflex.back()] = reflex_slot[i];
+    reflex.pop_back();
+    reflex_slot[i] = n;
+  }};
+
+  auto isEar {[&](unsigned int i) {
+    if (!isConvex(i))
+      return false;
+
+    for (const auto& other: reflex) {
+      if (other == prev[i] || other == next[i])
+        continue;
+
+      if (inTriangle(vertices[other], vertices[prev[i]], vertices[i], vertices[next[i]]))
+        return false;
+    }
+
+    return true;
+  }};
+
+  std::vector<char> is_ear (n);
+  std::vector<unsigned int> ears {};
+  for (unsigned int i {0}; i < n; i++) {
+    is_ear[i] = isEar(i);
+
+    if (is_ear[i])
+      ears.push_back(i);
+  }
+
+  std::vector<char> clipped (n, 0);
+  unsigned int remaining {n};
+  unsigned int last {0};
+
+  while (remaining > 3 && !ears.empty()) {
+    const auto curr {ears.back()};
+    ears.pop_back();
+
+    // Stale entries of clipped vertices or of vertices that stopped being ears
+    if (clipped[curr] || !is_ear[curr])
+      continue;
+
+    triangles.push_back({prev[curr], curr, next[curr]});
+    clipped[curr] = 1;
+    remaining--;
+
+    next[prev[curr]] = next[curr];
+    prev[next[curr]] = prev[curr];
+    last = next[curr];
+
+    // Only the two neighbors changed their corner
+    for (const auto neighbor: {prev[curr], next[curr]}) {
+      if (isConvex(neighbor))
+        removeReflex(neighbor);
+
+      const bool was_ear {is_ear[neighbor] != 0};
+      is_ear[neighbor] = isEar(neighbor);
+
+      if (is_ear[neighbor] && !was_ear)
+        ears.push_back(neighbor);
+    }
+  }
+
+  // Self-intersecting input runs out of ears, what is left is kept as is
+  std::vector<unsigned int> rest {last};
+  for (auto i {next[last]}; i != last; i = next[i])
+    rest.push_back(i);
+
+  triangles.push_back(rest);
+
+  return triangles;
+}
+
+std::vector<project2::PolygonPoints> project2::decomposeConvex(
+  const project2::PolygonPoints& points)
+{
+  auto polygon {project2::normalizePolygon(points)};
+
+  // Fewer than three vertices enclose nothing
+  if (polygon.size() < 6)
+    return {};
+
+  if (project2::isConvexPolygon(polygon))
+    return {polygon};
+
+  auto vertices {toVertices(polygon)};
+  const auto triangles {project2::triangulatePolygon(polygon)};
+
+  // Half-edges a -> b of the pieces, with the vertex before a and the one
+  // after b in the same piece. A diagonal is the pair a -> b, b -> a.
+  struct Corner {
+    unsigned int before;
+    unsigned int after;
+  };
+
+  auto getKey {[](unsigned int a, unsigned int b) {
+    return static_cast<std::uint64_t>(a) << 32 | b;
+  }};
+
+  std::unordered_map<std::uint64_t, Corner> half_edges {};
+  half_edges.reserve(3 * triangles.size());
+
+  for (const auto& piece: triangles) {
+    const auto size {piece.size()};
+
+    for (unsigned long e {0}; e < size; e++) {
+      half_edges[getKey(piece[e], piece[(e + 1) % size])] = {
+        piece[(e + size - 1) % size], piece[(e + 2) % size]};
+    }
+  }
+
+  // A single pass is enough: removing a diagonal only widens the corners of
+  // the others, one that can't go now never can
+  for (const auto& piece: triangles) {
+    const auto size {piece.size()};
+
+    for (unsigned long e {0}; e < size; e++) {
+      const auto a {piece[e]};
+      const auto b {piece[(e + 1) % size]};
+
+      // Polygon edges are never shared, each diagonal is visited from its lower end
+      if (a > b || (a + 1) % vertices.size() == b)
+        continue;
+
+      const auto forward {half_edges.find(getKey(a, b))};
+      const auto backward {half_edges.find(getKey(b, a))};
+
+      if (forward == half_edges.end() || backward == half_edges.end())
+        continue;
+
+      // Corners at a and b of the merged piece
+      const auto before_a {forward->second.before};
+      const auto after_a {backward->second.after};
+      const auto before_b {backward->second.before};
+      const auto after_b {forward->second.after};
+
+      if (cross(vertices[before_a], vertices[a], vertices[after_a]) < 0
+        || cross(vertices[before_b], vertices[b], vertices[after_b]) < 0)
+        continue;
+
+      half_edges.erase(forward);
+      half_edges.erase(backward);
+
+      half_edges[getKey(before_a, a)].after = after_a;
+      half_edges[getKey(a, after_a)].before = before_a;
+      half_edges[getKey(before_b, b)].after = after_b;
+      half_edges[getKey(b, after_b)].before = before_b;
+    }
+  }
+
+  // Walk every piece once, starting from the first of its triangles
+  std::vector<project2::PolygonPoints> convex_polygons {};
+
+  for (const auto& piece: triangles) {
+    const auto size {piece.size()};
+
+    for (unsigned long e {0}; e < size; e++) {
+      auto edge {half_edges.find(getKey(piece[e], piece[(e + 1) % size]))};
+
+      if (edge == half_edges.end())
+        continue;
+
+      project2::PolygonPoints piece_points {};
+      auto a {piece[e]};
+      auto b {piece[(e + 1) % size]};
+
+      while (edge != half_edges.end()) {
+        piece_points.push_back(static_cast<unsigned int>(vertices[a].x));
+        piece_points.push_back(static_cast<unsigned int>(vertices[a].y));
+
+        const auto after {edge->second.after};
+        half_edges.erase(edge);
+
+        a = b;
+        b = after;
+        edge = half_edges.find(getKey(a, b));
+      }
+
+      convex_polygons.push_back(project2::normalizePolygon(piece_points));
+    }
+  }
+
+  return convex_polygons;
+}
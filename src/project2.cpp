@@ -10,147 +10,317 @@
  */
 
 #include <cmath>
-#include <unordered_map>
+#include <limits>
 
 #include "shader.hpp"
 #include "project2.hpp"
+#include "grid_search.hpp"
 
-project2::OpenList::OpenList()
+namespace {
+
+// Halvings of the root bracket, far more than a double needs
+constexpr unsigned int ellipse_bisection_steps {64};
+
+/**
+ * @brief Distance from a point outside an ellipse to the ellipse, both in the
+ * first quadrant of the ellipse frame with semi-axes e0 >= e1 (Eberly,
+ * Distance from a Point to an Ellipse). The closest point is
+ * (r0 * y0 / (s + r0), y1 / (s + 1)) with r0 = (e0 / e1)^2, where s is the
+ * single root of a function that is monotonic on the bracket bisected here.
+ *
+ */
+double getEllipseDistance(double e0, double e1, double y0, double y1)
+{
+  if (y0 == 0.)
+    return y1 - e1;
+
+  if (y1 == 0.)
+    return y0 - e0;
+
+  const double z0 {y0 / e0};
+  const double z1 {y1 / e1};
+  const double r0 {(e0 / e1) * (e0 / e1)};
+  const double n0 {r0 * z0};
+
+  double s0 {z1 - 1.};
+  double s1 {std::hypot(n0, z1) - 1.};
+  double s {s0};
+
+  for (unsigned int i {0}; i < ellipse_bisection_steps; i++) {
+    s = 0.5 * (s0 + s1);
+
+    if (s == s0 || s == s1)
+      break;
+
+    const double ratio0 {n0 / (s + r0)};
+    const double ratio1 {z1 / (s + 1.)};
+    const double g {ratio0 * ratio0 + ratio1 * ratio1 - 1.};
+
+    if (g > 0.)
+      s0 = s;
+    else if (g < 0.)
+      s1 = s;
+    else
+      break;
+  }
+
+  return std::hypot(r0 * y0 / (s + r0) - y0, y1 / (s + 1.) - y1);
+}
+
+}
+
+project2::Obstacle::Obstacle(
+  unsigned int clearance,
+  const project2::GridSpec& grid_spec)
+: clearance_ {clearance},
+  grid_spec_ {grid_spec}
 {}
 
 project2::ObstacleSpace::ObstacleSpace(
   const std::vector<unsigned int>& points,
   unsigned int clearance,
-  const TwoDE::vec2ui& view_size)
-: clearance_ {clearance},
-  view_size_ {view_size}
+  const project2::GridSpec& grid_spec)
+: Obstacle(clearance, grid_spec),
+  convex_polygons_ {project2::decomposeConvex(points)}
 {
-  getCoefficients(points);
+  // Inflating thin decomposition pieces separately grows long miter spikes
+  // at their sharp corners, bevel them.
+  for (const auto& convex_polygon: convex_polygons_)
+    getCoefficients(convex_polygon, convex_polygons_.size() > 1);
 }
 
-bool project2::ObstacleSpace::containsPoint(const Position& position)
+bool project2::ObstacleSpace::containsPoint(const Position& position) const
 {
+  if (inBoundaryClearance(position))
+    return true;
+
   float dist {};
-  for (const auto& line: lines_) {
-    if (position.x < 0 + clearance_ || position.x > view_size_.x - clearance_
-      || position.y < 0 + clearance_ || position.y > view_size_.y - clearance_) {
+  for (const auto& lines: convex_lines_) {
+    bool inside {true};
+
+    for (const auto& line: lines) {
+      dist = -1.F * ((line.x_diff * (position.y - line.y1)) - ((position.x - line.x1) * line.y_diff)) * line.distance_inv;
+      if (dist >= clearance_) {
+        inside = false;
+        break;
+      }
+    }
 
+    if (inside)
       return true;
-    }
+  }
 
-    dist = -1.F * ((line.x_diff * (position.y - line.y1)) - ((position.x - line.x1) * line.y_diff)) * line.distance_inv;
-    if (dist >= clearance_) {
-      return false;
+  return false;
+}
+
+project2::Bounds project2::ObstacleSpace::getBounds() const
+{
+  project2::Bounds bounds {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+    std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+  // Offset lines of neighboring edges meet at c * (n_in + n_out) / (1 + n_in . n_out)
+  // from the corner. Beveled corners only cut that miter point off.
+  for (const auto& polygon: convex_polygons_) {
+    const auto n {polygon.size() / 2};
+
+    for (unsigned long i {0}; i < n; i++) {
+      const auto prev {(i + n - 1) % n};
+      const auto next {(i + 1) % n};
+      const auto x {static_cast<float>(polygon[2 * i])};
+      const auto y {static_cast<float>(polygon[2 * i + 1])};
+
+      // Outward normals of a counter-clockwise polygon
+      project2::TwoPoints line_in {static_cast<float>(polygon[2 * prev]), static_cast<float>(polygon[2 * prev + 1]), x, y};
+      project2::TwoPoints line_out {x, y, static_cast<float>(polygon[2 * next]), static_cast<float>(polygon[2 * next + 1])};
+      float normal_in_x {line_in.y_diff * line_in.distance_inv};
+      float normal_in_y {-line_in.x_diff * line_in.distance_inv};
+      float normal_out_x {line_out.y_diff * line_out.distance_inv};
+      float normal_out_y {-line_out.x_diff * line_out.distance_inv};
+      float scale {clearance_ / (1.F + normal_in_x * normal_out_x + normal_in_y * normal_out_y)};
+
+      float corner_x {x + scale * (normal_in_x + normal_out_x)};
+      float corner_y {y + scale * (normal_in_y + normal_out_y)};
+
+      bounds.x_min = std::min(bounds.x_min, corner_x);
+      bounds.y_min = std::min(bounds.y_min, corner_y);
+      bounds.x_max = std::max(bounds.x_max, corner_x);
+      bounds.y_max = std::max(bounds.y_max, corner_y);
     }
   }
 
-  return true;
+  return bounds;
 }
 
-void project2::ObstacleSpace::getCoefficients(const std::vector<unsigned int>& points)
+void project2::ObstacleSpace::getCoefficients(
+  const std::vector<unsigned int>& points,
+  bool bevel_corners)
 {
   auto points_ {points};
 
   points_.push_back(*points.begin());
   points_.push_back(*(points.begin() + 1));
 
+  std::vector<project2::TwoPoints> lines {};
+
   for (auto i {points_.begin()}; i < points_.end() - 2; i += 2) {
     auto x1 {static_cast<float>(*i)};
     auto y1 {static_cast<float>(*(i + 1))};
     auto x2 {static_cast<float>(*(i + 2))};
     auto y2 {static_cast<float>(*(i + 3))};
 
-    lines_.push_back({x1, y1, x2, y2});
+    lines.push_back({x1, y1, x2, y2});
+  }
+
+  // Unit line through each corner, normal to the bisector of its edges
+  const auto num_lines {lines.size()};
+  for (unsigned long i {0}; bevel_corners && i < num_lines; i++) {
+    const auto& line_in {lines[i]};
+    const auto& line_out {lines[(i + 1) % num_lines]};
+
+    float normal_x {line_in.y_diff * line_in.distance_inv + line_out.y_diff * line_out.distance_inv};
+    float normal_y {-line_in.x_diff * line_in.distance_inv - line_out.x_diff * line_out.distance_inv};
+    float normal_inv {1.F / std::sqrt(normal_x * normal_x + normal_y * normal_y)};
+
+    lines.push_back({line_out.x1, line_out.y1,
+      line_out.x1 - normal_y * normal_inv, line_out.y1 + normal_x * normal_inv});
   }
 
+  convex_lines_.push_back(lines);
 }
 
-bool project2::searchDijkstra(
-  project2::Node& start_node,
-  project2::Node& goal_node,
-  std::vector<ObstacleSpace>& obstacles,
-  std::deque<TwoDE::vec2ui>& explored_nodes,
-  std::deque<TwoDE::vec2ui>& backtracked_path,
-  const bool& continue_search,
-  bool& search_complete)
+project2::CircleObstacle::CircleObstacle(
+  const TwoDE::vec2ui& center,
+  unsigned int radius,
+  unsigned int clearance,
+  const project2::GridSpec& grid_spec,
+  unsigned int display_segments)
+: Obstacle(clearance, grid_spec),
+  center_x_ {static_cast<float>(center.x)},
+  center_y_ {static_cast<float>(center.y)},
+  radius_ {static_cast<float>(radius)},
+  inflated_radius_sq_ {std::pow(static_cast<float>(radius + clearance), 2.F)},
+  display_segments_ {display_segments}
+{}
+
+bool project2::CircleObstacle::containsPoint(const Position& position) const
 {
-  project2::OpenList open_list {};
-  std::unordered_map<project2::Position, project2::Node> closed_list {};
+  if (inBoundaryClearance(position))
+    return true;
 
-  open_list.push(start_node);
-  bool goal_node_found {false};
+  float x_diff {position.x - center_x_};
+  float y_diff {position.y - center_y_};
 
-  std::cout << '\n' << "Searching..." << '\n';
-  auto t_begin {std::chrono::high_resolution_clock::now()};
+  return (x_diff * x_diff + y_diff * y_diff < inflated_radius_sq_);
+}
 
-  while (!open_list.empty() && continue_search) {
-    auto current_node {open_list.top()};
-    open_list.pop();
-    closed_list.insert({current_node.getPosition(), current_node});
+project2::Bounds project2::CircleObstacle::getBounds() const
+{
+  float reach {radius_ + clearance_};
 
-    TwoDE::vec2ui current_node_pos {};
-    current_node_pos.x = current_node.getPosition().x;
-    current_node_pos.y = current_node.getPosition().y;
+  return {center_x_ - reach, center_y_ - reach, center_x_ + reach, center_y_ + reach};
+}
 
-    explored_nodes.push_back(current_node_pos);
+std::vector<project2::PolygonPoints> project2::CircleObstacle::getDisplayPolygons() const
+{
+  project2::PolygonPoints points {};
+  TwoDE::generateEllipsePoints(points,
+    {static_cast<unsigned int>(center_x_), static_cast<unsigned int>(center_y_)},
+    static_cast<unsigned int>(radius_), static_cast<unsigned int>(radius_),
+    0.F, display_segments_, false);
 
-    if (current_node == goal_node) {
-      goal_node_found = true;
-      goal_node = current_node;
-      closed_list.insert({current_node.getPosition(), current_node});
-      break;
-    }
+  return {points};
+}
 
-    project2::Node child_node {};
+project2::EllipseObstacle::EllipseObstacle(
+  const TwoDE::vec2ui& center,
+  unsigned int radius_x,
+  unsigned int radius_y,
+  float angle,
+  unsigned int clearance,
+  const project2::GridSpec& grid_spec,
+  unsigned int display_segments)
+: Obstacle(clearance, grid_spec),
+  center_x_ {static_cast<float>(center.x)},
+  center_y_ {static_cast<float>(center.y)},
+  radius_x_ {static_cast<float>(radius_x)},
+  radius_y_ {static_cast<float>(radius_y)},
+  angle_ {angle},
+  cos_angle_ {std::cos(angle)},
+  sin_angle_ {std::sin(angle)},
+  radius_x_inv_sq_ {1.F / (radius_x_ * radius_x_)},
+  radius_y_inv_sq_ {1.F / (radius_y_ * radius_y_)},
+  display_segments_ {display_segments}
+{}
 
-    for (const auto& action: project2::actions_list) {
-      if (!current_node.actionMove(action, child_node))
-        continue;
+bool project2::EllipseObstacle::containsPoint(const Position& position) const
+{
+  if (inBoundaryClearance(position))
+    return true;
 
-      bool in_obstacle_space {project2::inObstacleSpace(child_node.getPosition(), obstacles)};
+  // Point in the ellipse frame
+  float x_diff {position.x - center_x_};
+  float y_diff {position.y - center_y_};
+  float u {cos_angle_ * x_diff + sin_angle_ * y_diff};
+  float v {-sin_angle_ * x_diff + cos_angle_ * y_diff};
 
-      if (in_obstacle_space)
-        continue;
+  if (u * u * radius_x_inv_sq_ + v * v * radius_y_inv_sq_ <= 1.F)
+    return true;
 
-      if (closed_list.find(child_node.getPosition()) != closed_list.end())
-        continue;
+  // Outside the box around the inflated ellipse, no distance needed
+  float abs_u {std::abs(u)};
+  float abs_v {std::abs(v)};
 
-      auto found_open_list_node {open_list.find(child_node)};
+  if (abs_u >= radius_x_ + clearance_ || abs_v >= radius_y_ + clearance_)
+    return false;
 
-      if (found_open_list_node == open_list.end()) {
-        open_list.push(child_node);
-        continue;
-      }
+  double distance {radius_x_ >= radius_y_
+    ? getEllipseDistance(radius_x_, radius_y_, abs_u, abs_v)
+    : getEllipseDistance(radius_y_, radius_x_, abs_v, abs_u)};
 
-      if (found_open_list_node != open_list.end() && child_node < *found_open_list_node) {
-        open_list.erase(found_open_list_node);
-        open_list.push(child_node);
-      }
-    }
-  }
-  auto t_end {std::chrono::high_resolution_clock::now()};
+  return (distance < clearance_);
+}
 
-  std::chrono::duration<float, std::ratio<1L, 1L>> exec_time {t_end - t_begin};
+project2::Bounds project2::EllipseObstacle::getBounds() const
+{
+  // The clearance band lies within clearance of the ellipse, so inside the
+  // circle of the larger radius grown by it
+  float reach {std::max(radius_x_, radius_y_) + clearance_};
 
-  if (!goal_node_found)
-    return false;
+  return {center_x_ - reach, center_y_ - reach, center_x_ + reach, center_y_ + reach};
+}
 
-  std::cout << '\n' << "-- Goal node found --" << '\n';
-  std::cout << goal_node << '\n' << '\n';
-  std::cout << "Execution time: " << exec_time.count() << " seconds" << '\n';
+std::vector<project2::PolygonPoints> project2::EllipseObstacle::getDisplayPolygons() const
+{
+  project2::PolygonPoints points {};
+  TwoDE::generateEllipsePoints(points,
+    {static_cast<unsigned int>(center_x_), static_cast<unsigned int>(center_y_)},
+    static_cast<unsigned int>(radius_x_), static_cast<unsigned int>(radius_y_),
+    angle_, display_segments_, false);
 
-  backtrackPath(start_node, goal_node, closed_list, backtracked_path);
-  search_complete = true;
+  return {points};
+}
 
-  return true;
+project2::SearchStatus project2::searchDijkstra(
+  project2::Node& start_node,
+  project2::Node& goal_node,
+  const project2::OccupancyGrid& occupancy_grid,
+  project2::SpscRingBuffer<TwoDE::vec2ui>& explored_nodes,
+  std::deque<TwoDE::vec2ui>& backtracked_path,
+  const project2::SearchLimits& limits,
+  std::atomic<bool>& search_complete,
+  const project2::DistanceField* clearance_cost)
+{
+  return project2::searchGrid<project2::EightConnected>(start_node, goal_node,
+    occupancy_grid, explored_nodes, backtracked_path, limits,
+    search_complete, clearance_cost);
 }
 
 bool project2::inObstacleSpace(
   const project2::Position& point,
-  std::vector<project2::ObstacleSpace>& obstacles_space)
+  const project2::ObstacleList& obstacles_space)
 {
-  for (auto& obstacle_space: obstacles_space) {
-    if (!obstacle_space.containsPoint(point))
+  for (const auto& obstacle_space: obstacles_space) {
+    if (!obstacle_space->containsPoint(point))
       continue;
 
     return true;
@@ -159,22 +329,6 @@ bool project2::inObstacleSpace(
   return false;
 }
 
-void project2::backtrackPath(
-  const project2::Node& start_node,
-  const project2::Node& goal_node,
-  const std::unordered_map<project2::Position, project2::Node>& closed_list,
-  std::deque<TwoDE::vec2ui>& backtracked_path)
-{
-  backtracked_path.clear();
-  auto current_node {closed_list.find(goal_node.getPosition())->second};
-
-  while (current_node != start_node) {
-    backtracked_path.push_front(TwoDE::vec2ui(current_node.getPosition().x, current_node.getPosition().y));
-
-    current_node = closed_list.find(current_node.getFromPosition())->second;
-  }
-}
-
 unsigned int project2::initShader()
 {
   auto vertex_shader_source {TwoDE::parseShader("../libs/project2d-engine/shaders/vertex.shader")};
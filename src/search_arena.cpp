@@ -0,0 +1,65 @@
+/**
+ * @file search_arena.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Implementation of the per-query monotonic allocation arena
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <memory>
+
+#include "search_arena.hpp"
+
+namespace {
+
+struct ThreadSlab {
+  std::unique_ptr<std::byte[]> data {};
+  std::size_t size {0};
+  bool in_use {false};
+};
+
+thread_local ThreadSlab thread_slab {};
+
+// Claims the slab of the calling thread, grown to at least slab_size
+ThreadSlab* acquireThreadSlab(std::size_t slab_size)
+{
+  if (thread_slab.in_use)
+    return nullptr;
+
+  if (thread_slab.size < slab_size) {
+    thread_slab.data = std::make_unique<std::byte[]>(slab_size);
+    thread_slab.size = slab_size;
+  }
+
+  thread_slab.in_use = true;
+
+  return &thread_slab;
+}
+
+}
+
+project2::SearchArena::SearchArena(
+  std::size_t slab_size,
+  std::pmr::memory_resource* upstream)
+: owns_slab_ {false},
+  buffer_ {}
+{
+  if (auto slab {acquireThreadSlab(slab_size)}) {
+    owns_slab_ = true;
+    buffer_.emplace(slab->data.get(), slab->size, upstream);
+  }
+  else {
+    buffer_.emplace(slab_size, upstream);
+  }
+}
+
+project2::SearchArena::~SearchArena()
+{
+  buffer_.reset();
+
+  if (owns_slab_)
+    thread_slab.in_use = false;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file search_scheduler.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Implementation of the round-robin scheduler of stepped searches
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <algorithm>
+
+#include "search_scheduler.hpp"
+
+project2::SearchScheduler::SearchScheduler(unsigned int thread_count)
+: in_flight_ {0},
+  failed_count_ {0},
+  stopping_ {false}
+{
+  thread_count = std::max(thread_count, 1U);
+  workers_.reserve(thread_count);
+
+  for (unsigned int i {0}; i < thread_count; i++)
+    workers_.emplace_back(&SearchScheduler::runWorker, this);
+}
+
+project2::SearchScheduler::~SearchScheduler()
+{
+  std::deque<Task> queued {};
+
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    stopping_ = true;
+    queued.swap(tasks_);
+  }
+
+  ready_.notify_all();
+
+  // Searches between steps end here, the ones mid-step end on their worker
+  for (auto& task: queued)
+    endTask(task, SearchStatus::CANCELLED);
+
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    in_flight_ -= queued.size();
+  }
+
+  idle_.notify_all();
+
+  for (auto& worker: workers_)
+    worker.join();
+}
+
+void project2::SearchScheduler::submit(SearchGenerator search, StepCallback on_step)
+{
+  {
+    std::lock_guard<std::mutex> lock {mutex_};
+    tasks_.push_back({std::move(search), std::move(on_step)});
+    in_flight_++;
+  }
+
+  ready_.notify_one();
+}
+
+void project2::SearchScheduler::wait()
+{
+  std::unique_lock<std::mutex> lock {mutex_};
+  idle_.wait(lock, [this] {return in_flight_ == 0;});
+}
+
+unsigned long project2::SearchScheduler::getInFlight() const
+{
+  std::lock_guard<std::mutex> lock {mutex_};
+  return in_flight_;
+}
+
+unsigned long project2::SearchScheduler::getFailedCount() const
+{
+  std::lock_guard<std::mutex> lock {mutex_};
+  return failed_count_;
+}
+
+bool project2::SearchScheduler::runStep(Task& task)
+{
+  if (!task.search.next())
+    return false;
+
+  const auto& step {task.search.value()};
+
+  if (task.on_step)
+    task.on_step(step);
+
+  return step.status == SearchStatus::RUNNING;
+}
+
+void project2::SearchScheduler::endTask(Task& task, SearchStatus status)
+{
+  if (task.on_step) {
+    // A callback that throws again has nothing left to be told
+    try {
+      task.on_step(SearchStep {status});
+    }
+    catch (...) {
+    }
+  }
+
+  // Frees the coroutine frame before the search counts as done
+  task = {};
+}
+
+void project2::SearchScheduler::runWorker()
+{
+  while (true) {
+    std::unique_lock<std::mutex> lock {mutex_};
+    ready_.wait(lock, [this] {return stopping_ || !tasks_.empty();});
+
+    if (stopping_)
+      return;
+
+    auto task {std::move(tasks_.front())};
+    tasks_.pop_front();
+    lock.unlock();
+
+    // One step runs outside of the lock, the other workers keep going
+    bool finished {false};
+    bool failed {false};
+
+    try {
+      finished = !runStep(task);
+    }
+    catch (...) {
+      finished = true;
+      failed = true;
+    }
+
+    if (failed) {
+      endTask(task, SearchStatus::FAILED);
+    }
+    else if (finished) {
+      task = {};
+    }
+    else {
+      lock.lock();
+
+      if (!stopping_) {
+        tasks_.push_back(std::move(task));
+        lock.unlock();
+        ready_.notify_one();
+        continue;
+      }
+
+      lock.unlock();
+      endTask(task, SearchStatus::CANCELLED);
+    }
+
+    lock.lock();
+    failed_count_ += failed;
+
+    if (--in_flight_ == 0) {
+      lock.unlock();
+      idle_.notify_all();
+    }
+  }
+}
@@ -0,0 +1,40 @@
+/**
+ * @file sparse_workspace.cpp
+ * @author Abhishekh Reddy (areddy42@umd.edu)
+ * @brief Implementation of the search buffers for unbounded or sparse maps
+ * @version 0.1
+ * @date 2024-03-16
+ *
+ * @copyright Copyright (c) 2024 Abhishekh Reddy
+ *
+ */
+
+#include <limits>
+
+#include "sparse_workspace.hpp"
+
+project2::SparsePlannerWorkspace::SparsePlannerWorkspace()
+{}
+
+void project2::SparsePlannerWorkspace::reset()
+{
+  node_ids_.clear();
+  cells_.clear();
+  distances_.clear();
+  parents_.clear();
+  open_list_.clear();
+  path_.clear();
+}
+
+std::uint32_t project2::SparsePlannerWorkspace::getNode(const project2::CellCoord& cell)
+{
+  const auto inserted {node_ids_.insert(cell, static_cast<std::uint32_t>(cells_.size()))};
+
+  if (inserted.second) {
+    cells_.push_back(cell);
+    distances_.push_back(std::numeric_limits<float>::infinity());
+    parents_.push_back(NODE_NO_PARENT);
+  }
+
+  return *inserted.first;
+}